@@ -39,18 +39,29 @@
 #endif
 #endif
 
+#include <atomic>
+
+#include <librevenge/librevenge.h>
+
 namespace librevenge
 {
 class RVNGBinaryData;
 class RVNGDrawingInterface;
 class RVNGPresentationInterface;
+class RVNGPropertyList;
+class RVNGPropertyListVector;
 class RVNGSpreadsheetInterface;
+class RVNGString;
 class RVNGTextInterface;
 class RVNGInputStream;
 }
 
 /**
 This class provides all the functions an application would need to parse StarOffice documents.
+
+\note the library does not keep any shared mutable state, so different
+documents can be parsed concurrently in different threads. Each parse
+must use its own input stream and its own interface.
 */
 class STOFFDocument
 {
@@ -82,7 +93,152 @@ public:
     STOFF_R_OLE_ERROR /** problem when reading the OLE structure*/,
     STOFF_R_PARSE_ERROR /** problem when parsing the file*/,
     STOFF_R_PASSWORD_MISSMATCH_ERROR /** problem when using the given password*/,
-    STOFF_R_UNKNOWN_ERROR /** unknown error*/
+    STOFF_R_UNKNOWN_ERROR /** unknown error*/,
+    STOFF_R_CANCELLED /** the parsing was cancelled or its time limit was reached*/,
+    STOFF_R_MEMORY_LIMIT_ERROR /** the parsing needed more memory than its budget*/
+  };
+
+  /** a small interface used to retrieve the profile of a parsing, see ParseOptions */
+  class ProfileCallback
+  {
+  public:
+    //! destructor
+    virtual ~ProfileCallback() {}
+    /** called at the end of the parsing for each type of record
+        \param name the record's name
+        \param count the number of records
+        \param numBytes the total size of the records
+        \param seconds the total time spent in the records, including their sub-records */
+    virtual void insertRecord(char const *name, unsigned long count, unsigned long numBytes, double seconds)=0;
+    /** called at the end of the parsing for each subsystem which creates big buffers
+        \param subsystem the subsystem's name
+        \param count the number of allocations
+        \param numBytes the total size of the allocations */
+    virtual void insertAllocation(char const *subsystem, unsigned long count, unsigned long numBytes)=0;
+  };
+
+  /** a structure used to define some parsing options */
+  struct ParseOptions {
+    //! constructor
+    ParseOptions()
+      : m_skippedTextRecords(nullptr)
+      , m_skippedTextBytes(nullptr)
+      , m_firstPage(0)
+      , m_lastPage(0)
+      , m_numPages(nullptr)
+      , m_cancel(nullptr)
+      , m_maxDuration(0)
+      , m_maxMemory(0)
+      , m_usedMemory(nullptr)
+      , m_profileCallback(nullptr)
+    {
+    }
+    /** the list of the text document's records which must be skipped without being decoded.
+
+        Only the records which are ignored when creating the document can be skipped:
+        'U' (layout cache), 'V' (redlines), 'M' (macros), 'j' (dictionaries) and 'd' (statistics),
+        ie. "UVMjd" skips all of them. */
+    char const *m_skippedTextRecords;
+    //! if set, it is filled with the number of bytes of the records skipped (see m_skippedTextRecords)
+    unsigned long *m_skippedTextBytes;
+    /** the first page of a drawing or a presentation to convert: 1 means the first page, 0 means no limit.
+
+        The objects of the pages outside the range are not converted and only the master pages
+        used by the selected pages are sent. If the document has less than m_firstPage pages,
+        the parsing returns STOFF_R_PARSE_ERROR. */
+    int m_firstPage;
+    //! the last page of a drawing or a presentation to convert: 0 means no limit
+    int m_lastPage;
+    /** if set, it is filled with the number of pages of a drawing or a presentation, ie.
+        all its pages and not only the pages of the range (0 if the document can not be read) */
+    int *m_numPages;
+    /** a flag which can be set by another thread to stop the parsing.
+
+        The flag is checked each time a record is read, the parsing then stops
+        and returns STOFF_R_CANCELLED. */
+    std::atomic<bool> const *m_cancel;
+    /** the maximum duration of the parsing in seconds: 0 means no limit.
+
+        When the time limit is reached, the parsing stops and returns STOFF_R_CANCELLED. */
+    double m_maxDuration;
+    /** the memory budget of the parsing in bytes: 0 means no limit.
+
+        The big buffers (spreadsheet cells, bitmaps, decrypted or uncompressed streams,
+        encoded property lists) are charged when they are created and given back when
+        they are released. When the memory currently charged exceeds the budget, the
+        parsing stops and returns STOFF_R_MEMORY_LIMIT_ERROR. */
+    unsigned long m_maxMemory;
+    //! if set, it is filled with the peak of the memory charged during the parsing (see m_maxMemory)
+    unsigned long *m_usedMemory;
+    /** if set, the records read and the big allocations are profiled and
+        the profile is sent to this callback when the parse function ends without exception.
+
+        \note profiling slows down the parsing */
+    ProfileCallback *m_profileCallback;
+  };
+
+  /** a small interface used by parseText to send the text of a document paragraph by paragraph */
+  class ParagraphCallback
+  {
+  public:
+    //! destructor
+    virtual ~ParagraphCallback() {}
+    /** called for each paragraph
+        \param text the paragraph's text encoded in UTF-8 */
+    virtual void insertParagraph(librevenge::RVNGString const &text)=0;
+  };
+
+  /** a column of a sheet retrieved by parseSpreadsheetColumns: the cell of row m_firstRow+i
+      is stored at position i of each array
+
+      \note m_types and m_values point to buffers owned by the library, which are only valid
+      during the call of ColumnCallback::insertColumn */
+  struct SpreadsheetColumn {
+    //! the cell type
+    enum CellType { C_EMPTY=0 /**< no content*/, C_NUMBER /**< a number*/, C_TEXT /**< a text*/, C_FORMULA /**< a formula*/ };
+    //! constructor
+    SpreadsheetColumn()
+      : m_column(0)
+      , m_firstRow(0)
+      , m_numRows(0)
+      , m_types(nullptr)
+      , m_values(nullptr)
+      , m_texts()
+      , m_formulas()
+    {
+    }
+    //! the column
+    int m_column;
+    //! the first row
+    int m_firstRow;
+    //! the number of rows, ie. the length of each array
+    unsigned long m_numRows;
+    //! the cells' type
+    CellType const *m_types;
+    //! the numbers and the formulas' computed values, NaN if the cell has no value
+    double const *m_values;
+    //! the texts encoded in UTF-8 (empty if the cell has no text)
+    librevenge::RVNGStringVector m_texts;
+    //! the formulas, for instance "=SUM($A1:B3)", with english function names (empty if the cell has no formula)
+    librevenge::RVNGStringVector m_formulas;
+  private:
+    SpreadsheetColumn(SpreadsheetColumn const &orig);
+    SpreadsheetColumn &operator=(SpreadsheetColumn const &orig);
+  };
+
+  /** a small interface used by parseSpreadsheetColumns to send the columns of a spreadsheet */
+  class ColumnCallback
+  {
+  public:
+    //! destructor
+    virtual ~ColumnCallback() {}
+    /** called for each column which contains some cells, sheet by sheet and column by column
+        \param sheet the sheet id (0 for the first sheet)
+        \param sheetName the sheet's name
+        \param column the column's data
+
+        \note the buffers of m_types and m_values are reused by the next call, so they must be copied to be kept */
+    virtual void insertColumn(int sheet, librevenge::RVNGString const &sheetName, SpreadsheetColumn const &column)=0;
   };
 
   /** Analyzes the content of an input stream to see if it can be parsed
@@ -92,6 +248,18 @@ public:
       the input stream can be parsed */
   static STOFFLIB Confidence isFileFormatSupported(librevenge::RVNGInputStream *input, Kind &kind);
 
+  /** Analyzes quickly an input stream to see if it can be parsed: only the compound file's
+      header, its directory entries and the first bytes of the main stream are read, ie. no
+      sub-stream is created.
+      \param input The input stream
+      \param kind The document kind ( filled if the file is supported )
+      \param version The StarOffice version: 3, 4, 5 or 0 if unknown ( filled if the file is supported )
+      \return A confidence value which represents the likelyhood that the content from
+      the input stream can be parsed
+
+      \note this check is less strict than isFileFormatSupported */
+  static STOFFLIB Confidence isFileFormatSupportedFast(librevenge::RVNGInputStream *input, Kind &kind, int &version);
+
   // ------------------------------------------------------------
   // the different main parsers
   // ------------------------------------------------------------
@@ -106,6 +274,14 @@ public:
    \note Reserved for future use. Actually, it only returns false */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=nullptr);
 
+  /** Parses the input stream content using some options. It will make callbacks to the functions provided by a
+     librevenge::RVNGTextInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param options The parsing options
+     \param password The file password */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGDrawingInterface class implementation when needed. This is often commonly called the
      'main parsing routine'.
@@ -116,6 +292,14 @@ public:
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=nullptr);
 
+  /** Parses the input stream content using some options. It will make callbacks to the functions provided by a
+     librevenge::RVNGDrawingInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param options The parsing options
+     \param password The file password */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGPresentationInterface class implementation when needed. This is often commonly called the
      'main parsing routine'.
@@ -126,6 +310,23 @@ public:
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password=nullptr);
 
+  /** Parses the input stream content using some options. It will make callbacks to the functions provided by a
+     librevenge::RVNGPresentationInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGPresentationInterface implementation
+     \param options The parsing options
+     \param password The file password */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+
+  /** Parses a drawing or a presentation and returns its number of pages, nothing is sent.
+
+     \note the whole document is parsed, so this costs as much as a conversion. When a document
+     is converted, ParseOptions::m_numPages can be used to retrieve its number of pages.
+     \param input The input stream
+     \param numPages The number of pages
+     \param password The file password */
+  static STOFFLIB Result countPages(librevenge::RVNGInputStream *input, int &numPages, char const *password=nullptr);
+
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGSpreadsheetInterface class implementation when needed. This is often commonly called the
      'main parsing routine'.
@@ -136,6 +337,102 @@ public:
    \note Can only convert some basic documents: retrieving more cells' contents but no formating. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=nullptr);
 
+  /** Parses the input stream content using some options. It will make callbacks to the functions provided by a
+     librevenge::RVNGSpreadsheetInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGSpreadsheetInterface implementation
+     \param options The parsing options
+     \param password The file password */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, ParseOptions const &options, char const *password=nullptr);
+
+  // ------------------------------------------------------------
+  // fast text extraction
+  // ------------------------------------------------------------
+
+  /** Retrieves the text of a text document and sends it paragraph by paragraph to a callback.
+     Only the main text zones are read: the attributes, the formats, the styles, the fly frames,
+     the layout and the pictures are skipped.
+     \param input The input stream
+     \param callback The callback which receives the paragraphs
+     \param password The file password
+
+   \note only the text of the main body (including its tables and sections) is retrieved, ie. the text of the
+   headers, footers, frames and the content of the fields are ignored. */
+  static STOFFLIB Result parseText(librevenge::RVNGInputStream *input, ParagraphCallback &callback, char const *password=nullptr);
+
+  /** Retrieves the statistics of a text document: only the main zone's header and its statistics
+     record are read. If the document does not contain this record, the numbers of paragraphs, words and
+     characters are computed from the main text.
+     \param input The input stream
+     \param statistics The statistics: "meta:page-count", "meta:paragraph-count", "meta:word-count",
+     "meta:character-count", "meta:table-count", "meta:image-count" and "meta:object-count"
+     \param password The file password */
+  static STOFFLIB Result parseStatistics(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &statistics, char const *password=nullptr);
+
+  // ------------------------------------------------------------
+  // meta data
+  // ------------------------------------------------------------
+
+  /** Retrieves the meta data of a document (title, author, keywords, dates, ...) without
+     parsing the document's content: only the "SfxDocumentInfo" and "SummaryInformation" zones are read.
+     \param input The input stream
+     \param metaData The meta data, filled with the same keys than the one sent to setDocumentMetaData
+
+   \note returns STOFF_R_OK with an empty list if the document does not contain any meta data. */
+  static STOFFLIB Result parseMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData);
+
+  /** Retrieves the preview stored in a document without parsing the document's content:
+     only the "SfxPreview" zone is read.
+     \param input The input stream
+     \param data The preview data
+     \param mimeType The preview type: "image/bmp" if the preview contains a bitmap, if not "image/x-svm", ie. the original StarView metafile
+
+   \note returns STOFF_R_PARSE_ERROR if the document does not contain any preview. */
+  static STOFFLIB Result parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &data, librevenge::RVNGString &mimeType);
+
+  // ------------------------------------------------------------
+  // random access to the spreadsheet's cells
+  // ------------------------------------------------------------
+
+  /** Parses a spreadsheet and creates an index which stores the position of each column's data.
+     This index can then be saved and used by parseSpreadsheetCells to retrieve quickly some cells.
+     \param input The input stream
+     \param index The binary index (filled if the parsing succeeds)
+     \param password The file password
+
+   \note the index also stores a checksum of the main calc stream, so it is rejected if the file has changed. */
+  static STOFFLIB Result createSpreadsheetIndex(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &index, char const *password=nullptr);
+
+  /** Retrieves the content of the cells of a sheet's column between minRow and maxRow without parsing
+     the whole document. Each cell is returned as a property list which contains "librevenge:row",
+     "librevenge:column" and, if defined, "librevenge:value-type", "librevenge:value", "librevenge:text"
+     and "librevenge:formula".
+     \param input The input stream
+     \param index An index created by createSpreadsheetIndex
+     \param sheet The sheet id (0 for the first sheet)
+     \param column The column id
+     \param minRow, maxRow The range of rows to retrieve
+     \param cells The list of cells
+     \param password The file password
+     \param checkIndex If true, the checksum of the spreadsheet zone is computed and compared with the
+     index's checksum, this reads the whole zone. A caller which has already checked that the index
+     corresponds to this document can set it to false.
+
+   \note the cells are not formatted. */
+  static STOFFLIB Result parseSpreadsheetCells(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData const &index,
+      int sheet, int column, int minRow, int maxRow,
+      librevenge::RVNGPropertyListVector &cells, char const *password=nullptr, bool checkIndex=true);
+
+  /** Retrieves the content of the cells of a spreadsheet column by column, without creating
+     any property list. Only the cells' contents are retrieved: the styles, the formats, the
+     notes and the graphics are ignored.
+     \param input The input stream
+     \param callback The callback which receives the columns
+     \param password The file password
+
+   \note the numbers are not formatted, ie. a date is returned as a number of days. */
+  static STOFFLIB Result parseSpreadsheetColumns(librevenge::RVNGInputStream *input, ColumnCallback &callback, char const *password=nullptr);
+
   // ------------------------------------------------------------
   // decoders of the embedded zones created by libstoff
   // ------------------------------------------------------------
@@ -0,0 +1,532 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <librevenge-generators/RVNGDummyDrawingGenerator.h>
+#include <librevenge-generators/RVNGDummyPresentationGenerator.h>
+#include <librevenge-generators/RVNGDummySpreadsheetGenerator.h>
+#include <librevenge-generators/RVNGDummyTextGenerator.h>
+
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libstaroffice/libstaroffice.hxx>
+
+#ifndef PACKAGE
+#define PACKAGE "libstaroffice"
+#endif
+
+#define TOOLNAME "sdbench"
+
+static int printUsage()
+{
+  printf("`" TOOLNAME "' is used to measure the performance of " PACKAGE ".\n");
+  printf("\n");
+  printf("Usage: " TOOLNAME " [OPTION] DIRECTORY...\n");
+  printf("\n");
+  printf("Parses each supported file of the directories into the librevenge dummy generators.\n");
+  printf("Each file is parsed in a child process, so its peak resident set size does not depend\n");
+  printf("on the files parsed before. The buffers column counts the big buffers charged to the\n");
+  printf("memory budget of the parsing, not all the allocations. If the parsing of a file crashes,\n");
+  printf("the other files are still parsed but " TOOLNAME " fails.\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t-b BASELINE        compare the times with a JSON file created by a previous run\n");
+  printf("\t-h                 show this help message\n");
+  printf("\t-j NUM             then parse the whole corpus from 1, 2, ..., NUM threads at once and\n");
+  printf("\t                   report the throughput of each step\n");
+  printf("\t-n NUM             parse each file NUM times and keep the best time (default 3)\n");
+  printf("\t-o OUTPUT          write the results in a JSON file\n");
+  printf("\t-r ROOT            the directories are relative to ROOT, the files are named relative\n");
+  printf("\t                   to ROOT in the output and in the baseline\n");
+  printf("\t-t PERCENT         the tolerated slowdown compared to the baseline (default 20)\n");
+  printf("\n");
+  printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
+  return 0;
+}
+
+/** a profile callback which only counts the big buffers charged to
+    the memory budget of the parsing, ie. not all the allocations */
+class ChargedBufferCounter final : public STOFFDocument::ProfileCallback
+{
+public:
+  ChargedBufferCounter()
+    : STOFFDocument::ProfileCallback()
+    , m_count(0)
+    , m_size(0)
+  {
+  }
+  void insertRecord(char const */*name*/, unsigned long /*count*/, unsigned long /*numBytes*/, double /*seconds*/) final
+  {
+  }
+  void insertAllocation(char const */*subsystem*/, unsigned long count, unsigned long numBytes) final
+  {
+    m_count+=count;
+    m_size+=numBytes;
+  }
+  //! the number of charged buffers
+  unsigned long m_count;
+  //! the total size of the charged buffers
+  unsigned long m_size;
+};
+
+//! the result of a file's benchmark
+struct BenchResult {
+  //! the file name
+  std::string m_file;
+  //! the document kind
+  char const *m_kind;
+  //! the file size
+  unsigned long m_size;
+  //! the parse result
+  int m_status;
+  //! the best time in seconds
+  double m_time;
+  //! the number of big buffers charged to the memory budget
+  unsigned long m_numChargedBuffers;
+  //! the size of the big buffers charged to the memory budget
+  unsigned long m_chargedBytes;
+  //! the peak resident set size of the child process which has parsed the file (in kB)
+  long m_peakRSS;
+};
+
+static bool readFile(std::string const &path, std::vector<unsigned char> &data)
+{
+  data.clear();
+  FILE *file=fopen(path.c_str(), "rb");
+  if (!file) return false;
+  unsigned char buffer[65536];
+  size_t numRead;
+  while ((numRead=fread(buffer, 1, sizeof(buffer), file))>0)
+    data.insert(data.end(), buffer, buffer+numRead);
+  fclose(file);
+  return !data.empty();
+}
+
+//! appends the files of root/dir in files, the files are named dir/name
+static void listFiles(std::string const &root, std::string const &dir, std::vector<std::string> &files)
+{
+  DIR *directory=opendir((root+dir).c_str());
+  if (!directory) {
+    fprintf(stderr, "ERROR: can not open the directory %s\n", dir.c_str());
+    return;
+  }
+  std::vector<std::string> names;
+  while (struct dirent *entry=readdir(directory)) {
+    if (entry->d_name[0]=='.') continue;
+    names.push_back(entry->d_name);
+  }
+  closedir(directory);
+  std::sort(names.begin(), names.end());
+  for (auto const &name : names)
+    files.push_back(dir+"/"+name);
+}
+
+static char const *getKindName(STOFFDocument::Kind kind)
+{
+  switch (kind) {
+  case STOFFDocument::STOFF_K_DRAW:
+  case STOFFDocument::STOFF_K_GRAPHIC:
+    return "drawing";
+  case STOFFDocument::STOFF_K_PRESENTATION:
+    return "presentation";
+  case STOFFDocument::STOFF_K_SPREADSHEET:
+  case STOFFDocument::STOFF_K_DATABASE:
+    return "spreadsheet";
+  case STOFFDocument::STOFF_K_TEXT:
+    return "text";
+  case STOFFDocument::STOFF_K_UNKNOWN:
+  case STOFFDocument::STOFF_K_BITMAP:
+  case STOFFDocument::STOFF_K_CHART:
+  case STOFFDocument::STOFF_K_MATH:
+  default:
+    break;
+  }
+  return nullptr;
+}
+
+static STOFFDocument::Result parse(std::vector<unsigned char> const &data, STOFFDocument::Kind kind, STOFFDocument::ParseOptions const &options)
+{
+  librevenge::RVNGStringStream input(data.data(), static_cast<unsigned int>(data.size()));
+  switch (kind) {
+  case STOFFDocument::STOFF_K_DRAW:
+  case STOFFDocument::STOFF_K_GRAPHIC: {
+    librevenge::RVNGDummyDrawingGenerator generator;
+    return STOFFDocument::parse(&input, &generator, options);
+  }
+  case STOFFDocument::STOFF_K_PRESENTATION: {
+    librevenge::RVNGDummyPresentationGenerator generator;
+    return STOFFDocument::parse(&input, &generator, options);
+  }
+  case STOFFDocument::STOFF_K_SPREADSHEET:
+  case STOFFDocument::STOFF_K_DATABASE: {
+    librevenge::RVNGDummySpreadsheetGenerator generator;
+    return STOFFDocument::parse(&input, &generator, options);
+  }
+  case STOFFDocument::STOFF_K_TEXT: {
+    librevenge::RVNGDummyTextGenerator generator;
+    return STOFFDocument::parse(&input, &generator, options);
+  }
+  case STOFFDocument::STOFF_K_UNKNOWN:
+  case STOFFDocument::STOFF_K_BITMAP:
+  case STOFFDocument::STOFF_K_CHART:
+  case STOFFDocument::STOFF_K_MATH:
+  default:
+    break;
+  }
+  return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+}
+
+//! reads a file and returns true if it is a supported document
+static bool readDocument(std::string const &file, std::vector<unsigned char> &data, STOFFDocument::Kind &kind)
+{
+  if (!readFile(file, data)) return false;
+  kind=STOFFDocument::STOFF_K_UNKNOWN;
+  try {
+    librevenge::RVNGStringStream input(data.data(), static_cast<unsigned int>(data.size()));
+    // the StarOffice files without password are often detected as "supported encryption"
+    auto confidence=STOFFDocument::isFileFormatSupported(&input, kind);
+    if (confidence!=STOFFDocument::STOFF_C_EXCELLENT && confidence!=STOFFDocument::STOFF_C_SUPPORTED_ENCRYPTION)
+      return false;
+  }
+  catch (...) {
+    return false;
+  }
+  return getKindName(kind)!=nullptr;
+}
+
+static bool benchmark(std::string const &file, int numRuns, BenchResult &result)
+{
+  std::vector<unsigned char> data;
+  STOFFDocument::Kind kind;
+  if (!readDocument(file, data, kind)) return false;
+  result.m_kind=getKindName(kind);
+  result.m_file=file;
+  result.m_size=static_cast<unsigned long>(data.size());
+
+  STOFFDocument::ParseOptions options;
+  result.m_time=0;
+  for (int run=0; run<numRuns; ++run) {
+    auto start=std::chrono::steady_clock::now();
+    result.m_status=int(parse(data, kind, options));
+    double time=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    if (run==0 || time<result.m_time)
+      result.m_time=time;
+  }
+  // a last run to count the charged buffers, profiling slows down the parsing
+  ChargedBufferCounter counter;
+  options.m_profileCallback=&counter;
+  parse(data, kind, options);
+  result.m_numChargedBuffers=counter.m_count;
+  result.m_chargedBytes=counter.m_size;
+  return true;
+}
+
+//! writes a value in a pipe
+template <class T> static bool writeValue(int fd, T const &value)
+{
+  return write(fd, &value, sizeof(T))==ssize_t(sizeof(T));
+}
+
+//! reads a value from a pipe
+template <class T> static bool readValue(int fd, T &value)
+{
+  return read(fd, &value, sizeof(T))==ssize_t(sizeof(T));
+}
+
+/** benchmarks a file in a child process and sets the result's peak
+    resident set size to the child's peak, crashed is set if the child
+    has been killed by a signal.
+
+    \note the child inherits the memory of this small process, so the
+    peak includes a constant part which is the same for all files */
+static bool benchmarkInChild(std::string const &file, int numRuns, BenchResult &result, bool &crashed)
+{
+  crashed=false;
+  int fds[2];
+  if (pipe(fds)!=0) return false;
+  pid_t pid=fork();
+  if (pid<0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid==0) {
+    close(fds[0]);
+    bool ok=benchmark(file, numRuns, result);
+    // the kind names are static strings, so their addresses are the same in the parent
+    ok=writeValue(fds[1], ok) && (!ok || (writeValue(fds[1], result.m_kind) && writeValue(fds[1], result.m_size) &&
+                                           writeValue(fds[1], result.m_status) && writeValue(fds[1], result.m_time) &&
+                                           writeValue(fds[1], result.m_numChargedBuffers) && writeValue(fds[1], result.m_chargedBytes)));
+    _exit(ok ? 0 : 1);
+  }
+  close(fds[1]);
+  bool ok=false;
+  result.m_file=file;
+  if (readValue(fds[0], ok) && ok)
+    ok=readValue(fds[0], result.m_kind) && readValue(fds[0], result.m_size) &&
+       readValue(fds[0], result.m_status) && readValue(fds[0], result.m_time) &&
+       readValue(fds[0], result.m_numChargedBuffers) && readValue(fds[0], result.m_chargedBytes);
+  close(fds[0]);
+  int status;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage)!=pid)
+    return false;
+  if (!WIFEXITED(status)) {
+    fprintf(stderr, "ERROR: the parsing of %s has crashed\n", file.c_str());
+    crashed=true;
+    return false;
+  }
+  result.m_peakRSS=long(usage.ru_maxrss);
+  return ok && WEXITSTATUS(status)==0;
+}
+
+//! a document of the corpus used to measure the scaling
+struct CorpusDocument {
+  //! the file content
+  std::vector<unsigned char> m_data;
+  //! the document kind
+  STOFFDocument::Kind m_kind;
+};
+
+/** parses the corpus from 1, 2, ..., maxThreads threads at once, each
+    thread parsing all the documents, and prints the throughput.
+
+    \note this only scales if the parsers do not share any state, so
+    running it in a ThreadSanitizer build is a good way to find data races */
+static bool measureScaling(std::vector<std::string> const &files, std::string const &root, int maxThreads)
+{
+  std::vector<CorpusDocument> corpus;
+  unsigned long corpusSize=0;
+  for (auto const &file : files) {
+    CorpusDocument doc;
+    if (!readDocument(root+file, doc.m_data, doc.m_kind))
+      continue;
+    corpusSize+=static_cast<unsigned long>(doc.m_data.size());
+    corpus.push_back(doc);
+  }
+  if (corpus.empty()) return true;
+  printf("\nscaling: %lu files, %lu bytes parsed by each thread\n", static_cast<unsigned long>(corpus.size()), corpusSize);
+  printf("%8s %10s %8s %8s\n", "threads", "time(ms)", "MB/s", "speedup");
+  bool ok=true;
+  double firstThroughput=0;
+  for (int numThreads=1; numThreads<=maxThreads; ++numThreads) {
+    std::vector<int> numErrors(size_t(numThreads), 0);
+    std::vector<std::thread> threads;
+    auto start=std::chrono::steady_clock::now();
+    for (int t=0; t<numThreads; ++t) {
+      threads.push_back(std::thread([&corpus,&numErrors,t]() {
+        STOFFDocument::ParseOptions options;
+        for (auto const &doc : corpus) {
+          if (parse(doc.m_data, doc.m_kind, options)!=STOFFDocument::STOFF_R_OK)
+            ++numErrors[size_t(t)];
+        }
+      }));
+    }
+    for (auto &thread : threads)
+      thread.join();
+    double time=std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    double throughput=time>0 ? double(numThreads)*double(corpusSize)/1048576./time : 0;
+    if (numThreads==1)
+      firstThroughput=throughput;
+    printf("%8d %10.3f %8.2f %8.2f", numThreads, 1000*time, throughput, firstThroughput>0 ? throughput/firstThroughput : 0);
+    // all the threads parse the same documents, so they must have the same number of errors
+    for (auto num : numErrors) {
+      if (num==numErrors[0]) continue;
+      printf(" ### the threads' results differ");
+      ok=false;
+      break;
+    }
+    printf("\n");
+  }
+  return ok;
+}
+
+//! returns the number of MB parsed by second
+static double getThroughput(BenchResult const &result)
+{
+  return result.m_time>0 ? double(result.m_size)/1048576./result.m_time : 0;
+}
+
+static std::string escapeJSON(std::string const &str)
+{
+  std::string res;
+  for (char c : str) {
+    if (c=='"' || c=='\\')
+      res+='\\';
+    res+=c;
+  }
+  return res;
+}
+
+/** writes the results in a JSON file
+
+    \note each file's result is written in one line, readBaseline relies on it */
+static bool writeJSON(char const *output, std::vector<BenchResult> const &results)
+{
+  FILE *file=fopen(output, "w");
+  if (!file) return false;
+  fprintf(file, "{\n\"files\": [\n");
+  for (size_t i=0; i<results.size(); ++i) {
+    auto const &res=results[i];
+    fprintf(file, "{\"file\": \"%s\", \"kind\": \"%s\", \"size\": %lu, \"status\": %d, \"time\": %.6f, \"throughput\": %.3f, \"chargedBuffers\": %lu, \"chargedBytes\": %lu, \"peakRSS\": %ld}%s\n",
+            escapeJSON(res.m_file).c_str(), res.m_kind, res.m_size, res.m_status, res.m_time, getThroughput(res), res.m_numChargedBuffers, res.m_chargedBytes, res.m_peakRSS,
+            i+1<results.size() ? "," : "");
+  }
+  fprintf(file, "]\n}\n");
+  fclose(file);
+  return true;
+}
+
+//! reads the time of each file in a JSON file created by writeJSON
+static bool readBaseline(char const *input, std::map<std::string, double> &fileToTimeMap)
+{
+  std::vector<unsigned char> data;
+  if (!readFile(input, data)) return false;
+  std::string content(data.begin(), data.end());
+  size_t pos=0;
+  while ((pos=content.find("{\"file\": \"", pos))!=std::string::npos) {
+    pos+=10;
+    std::string name;
+    for (; pos<content.size() && content[pos]!='"'; ++pos) {
+      if (content[pos]=='\\' && pos+1<content.size()) ++pos;
+      name+=content[pos];
+    }
+    auto timePos=content.find("\"time\": ", pos);
+    if (timePos==std::string::npos) break;
+    fileToTimeMap[name]=strtod(content.c_str()+timePos+8, nullptr);
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  bool printHelp=false;
+  char const *output=nullptr, *baseline=nullptr;
+  std::string root;
+  int numRuns=3, maxThreads=0;
+  double tolerance=20;
+  int ch;
+
+  while ((ch = getopt(argc, argv, "b:hj:n:o:r:t:")) != -1) {
+    switch (ch) {
+    case 'b':
+      baseline=optarg;
+      break;
+    case 'j':
+      maxThreads=atoi(optarg);
+      break;
+    case 'n':
+      numRuns=atoi(optarg);
+      break;
+    case 'o':
+      output=optarg;
+      break;
+    case 'r':
+      root=std::string(optarg)+"/";
+      break;
+    case 't':
+      tolerance=atof(optarg);
+      break;
+    default:
+    case 'h':
+      printHelp = true;
+      break;
+    }
+  }
+  if (argc == optind || numRuns<=0 || maxThreads<0 || tolerance<0 || printHelp) {
+    printUsage();
+    return -1;
+  }
+
+  std::vector<std::string> files;
+  for (int i=optind; i<argc; ++i)
+    listFiles(root, argv[i], files);
+
+  std::map<std::string, double> fileToBaseTimeMap;
+  if (baseline && !readBaseline(baseline, fileToBaseTimeMap))
+    fprintf(stderr, "WARNING: can not read the baseline %s, no comparison is done\n", baseline);
+
+  std::vector<BenchResult> results;
+  double totalTime=0;
+  int numRegressions=0, numCrashes=0;
+  printf("%-60s %-12s %10s %10s %8s %10s %12s %10s\n", "file", "kind", "size", "time(ms)", "MB/s", "buffers", "bytes", "RSS(kB)");
+  for (auto const &file : files) {
+    BenchResult res;
+    bool crashed;
+    if (!benchmarkInChild(root+file, numRuns, res, crashed)) {
+      if (crashed) ++numCrashes;
+      continue;
+    }
+    res.m_file=file;
+    results.push_back(res);
+    totalTime+=res.m_time;
+    printf("%-60s %-12s %10lu %10.3f %8.2f %10lu %12lu %10ld", res.m_file.c_str(), res.m_kind, res.m_size, 1000*res.m_time, getThroughput(res),
+           res.m_numChargedBuffers, res.m_chargedBytes, res.m_peakRSS);
+    if (res.m_status!=int(STOFFDocument::STOFF_R_OK))
+      printf(" error=%d", res.m_status);
+    auto it=fileToBaseTimeMap.find(file);
+    // ignore the differences smaller than a millisecond, they are mostly noise
+    if (it!=fileToBaseTimeMap.end() && res.m_time>it->second*(1+tolerance/100) && res.m_time-it->second>0.001) {
+      printf(" ### slower, baseline=%.3f ms", 1000*it->second);
+      ++numRegressions;
+    }
+    printf("\n");
+  }
+  printf("total: %lu files, %.3f ms\n", static_cast<unsigned long>(results.size()), 1000*totalTime);
+
+  if (maxThreads>0 && !measureScaling(files, root, maxThreads)) {
+    fprintf(stderr, "ERROR: the parsing from several threads does not give the same results\n");
+    return 1;
+  }
+
+  if (output && !writeJSON(output, results)) {
+    fprintf(stderr, "ERROR: can not write %s\n", output);
+    return 1;
+  }
+  if (numCrashes)
+    fprintf(stderr, "ERROR: the parsing of %d file(s) has crashed\n", numCrashes);
+  if (numRegressions)
+    fprintf(stderr, "ERROR: %d file(s) are slower than the baseline\n", numRegressions);
+  return (numCrashes || numRegressions) ? 1 : 0;
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
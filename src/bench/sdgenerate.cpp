@@ -0,0 +1,942 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-generators/librevenge-generators.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libstaroffice/libstaroffice.hxx>
+
+#ifndef PACKAGE
+#define PACKAGE "libstaroffice"
+#endif
+
+#define TOOLNAME "sdgenerate"
+
+static int printUsage()
+{
+  printf("`" TOOLNAME "' creates synthetic StarOffice 5 documents to measure the scaling of " PACKAGE ".\n");
+  printf("\n");
+  printf("Usage: " TOOLNAME " [OPTION] -t TYPE OUTPUT\n");
+  printf("\n");
+  printf("Writes an OLE file which only contains the main stream of the document:\n");
+  printf("\tcalc: NUM sheets of ROWS x COLUMNS cells: values, strings and formulas\n");
+  printf("\ttext: NUM paragraphs whose style and character attributes change\n");
+  printf("\tdraw: NUM shapes, ie. polygons and bitmaps, 64 shapes by page\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t-b SIZE            the width and the height of the bitmaps in pixels (default 32)\n");
+  printf("\t-c COLUMNS         the number of columns of each sheet (default 16, maximum 256)\n");
+  printf("\t-h                 show this help message\n");
+  printf("\t-n NUM             the number of sheets, paragraphs or shapes\n");
+  printf("\t                   (default 1, 1000 or 100)\n");
+  printf("\t-r ROWS            the number of rows of each sheet (default 1000, maximum 32000)\n");
+  printf("\t-t TYPE            the document type: calc, text or draw\n");
+  printf("\t-v                 parses the created file and checks its number of cells,\n");
+  printf("\t                   paragraphs or pages\n");
+  printf("\n");
+  printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
+  return 0;
+}
+
+//! a buffer used to create a little endian stream
+class StreamBuffer
+{
+public:
+  //! constructor
+  StreamBuffer()
+    : m_data()
+  {
+  }
+  //! returns the current position
+  size_t tell() const
+  {
+    return m_data.size();
+  }
+  //! adds an unsigned value stored in numBytes
+  void addULong(unsigned long value, int numBytes)
+  {
+    for (int i=0; i<numBytes; ++i, value>>=8)
+      m_data.push_back(static_cast<unsigned char>(value&0xff));
+  }
+  //! adds a signed value stored in numBytes
+  void addLong(long value, int numBytes)
+  {
+    addULong(static_cast<unsigned long>(value), numBytes);
+  }
+  //! adds a double
+  void addDouble(double value)
+  {
+    unsigned char buffer[8];
+    std::memcpy(buffer, &value, 8);
+    m_data.insert(m_data.end(), buffer, buffer+8);
+  }
+  //! adds some characters
+  void addBytes(char const *data, size_t length)
+  {
+    m_data.insert(m_data.end(), data, data+length);
+  }
+  //! adds a string: its length (2 bytes) followed by its characters
+  void addString(std::string const &string)
+  {
+    addULong(string.size(), 2);
+    addBytes(string.c_str(), string.size());
+  }
+  //! replaces the numBytes bytes at position pos by value
+  void setULong(size_t pos, unsigned long value, int numBytes)
+  {
+    for (int i=0; i<numBytes; ++i, value>>=8)
+      m_data[pos+size_t(i)]=static_cast<unsigned char>(value&0xff);
+  }
+  //! the data
+  std::vector<unsigned char> m_data;
+};
+
+////////////////////////////////////////////////////////////
+// the records
+////////////////////////////////////////////////////////////
+
+//! opens a record whose size (4 bytes) does not include the size field, see StarZone::openSCRecord
+static size_t openSCRecord(StreamBuffer &stream)
+{
+  size_t pos=stream.tell();
+  stream.addULong(0, 4);
+  return pos;
+}
+
+static void closeSCRecord(StreamBuffer &stream, size_t pos)
+{
+  stream.setULong(pos, stream.tell()-pos-4, 4);
+}
+
+//! opens a record whose size (4 bytes) includes the size field, see StarZone::openRecord
+static size_t openRecord(StreamBuffer &stream)
+{
+  size_t pos=stream.tell();
+  stream.addULong(0, 4);
+  return pos;
+}
+
+static void closeRecord(StreamBuffer &stream, size_t pos)
+{
+  stream.setULong(pos, stream.tell()-pos, 4);
+}
+
+//! opens a writer record: a type and a size (3 bytes), see StarZone::openSWRecord
+static size_t openSWRecord(StreamBuffer &stream, char type)
+{
+  size_t pos=stream.tell();
+  stream.addULong(static_cast<unsigned char>(type), 4);
+  return pos;
+}
+
+/** closes a writer record, the sizes which do not fit in 3 bytes are
+    stored in recordSizes and written at the end of the stream, see StarZone::readRecordSizes */
+static void closeSWRecord(StreamBuffer &stream, size_t pos, std::vector<std::pair<size_t, size_t> > &recordSizes)
+{
+  size_t size=stream.tell()-pos;
+  if (size>=0xffffff) {
+    recordSizes.push_back(std::make_pair(pos, size));
+    size=0xffffff;
+  }
+  stream.setULong(pos, stream.m_data[pos] | (size<<8), 4);
+}
+
+//! opens a drawing header: a magic, a version and a size, see StarZone::openSDRHeader
+static size_t openSDRHeader(StreamBuffer &stream, char const *magic, int version)
+{
+  size_t pos=stream.tell();
+  stream.addBytes(magic, 4);
+  stream.addULong(static_cast<unsigned long>(version), 2);
+  stream.addULong(0, 4);
+  return pos;
+}
+
+static void closeSDRHeader(StreamBuffer &stream, size_t pos)
+{
+  stream.setULong(pos+6, stream.tell()-pos, 4);
+}
+
+////////////////////////////////////////////////////////////
+// the spreadsheet
+////////////////////////////////////////////////////////////
+
+//! the version of the StarCalc 5 documents
+static int const s_calcVersion=0x205;
+
+//! adds the cells of a column, read by StarObjectSpreadsheet::readSCData
+static void addCalcColumnData(StreamBuffer &stream, int sheet, int column, int numRows)
+{
+  stream.addULong(0x4250, 2);
+  size_t pos=openSCRecord(stream);
+  stream.addULong(static_cast<unsigned long>(numRows), 2);
+  std::vector<size_t> formulaSizes;
+  char text[100];
+  for (int row=0; row<numRows; ++row) {
+    stream.addULong(static_cast<unsigned long>(row), 2);
+    double value=double(row)+double(column)/100;
+    switch (column%3) {
+    case 0:
+      stream.addULong(1, 1); // value
+      stream.addULong(0, 1);
+      stream.addDouble(value);
+      break;
+    case 1:
+      stream.addULong(2, 1); // string
+      stream.addULong(0, 1);
+      snprintf(text, sizeof(text), "text S%dR%dC%d", sheet+1, row+1, column+1);
+      stream.addString(text);
+      break;
+    default: {
+      stream.addULong(3, 1); // formula: the value two columns before multiplied by 2
+      size_t contentPos=stream.tell();
+      stream.addULong(0, 1); // cData
+      stream.addULong(8, 1); // cFlags: has a value
+      stream.addULong(0, 2); // formatType
+      stream.addDouble(2*(value-0.02));
+      // StarCellFormula::readSCFormula
+      stream.addULong(0x40, 1); // fFlags: has tokens
+      stream.addULong(0, 1); // cMode
+      stream.addULong(3, 2);
+      // StarCellFormula::readSCToken: push cell (relative column and row)
+      stream.addULong(0, 2);
+      stream.addULong(3, 1);
+      stream.addLong(column-2, 2);
+      stream.addLong(row, 2);
+      stream.addLong(sheet, 2);
+      stream.addULong(5, 1);
+      // *
+      stream.addULong(23, 2);
+      stream.addULong(0, 1);
+      stream.addULong(0, 1);
+      // push 2
+      stream.addULong(0, 2);
+      stream.addULong(1, 1);
+      stream.addDouble(2);
+      formulaSizes.push_back(stream.tell()-contentPos);
+      break;
+    }
+    }
+  }
+  closeSCRecord(stream, pos);
+  stream.addULong(0x4200, 2);
+  stream.addULong(4*formulaSizes.size(), 4);
+  for (auto size : formulaSizes)
+    stream.addULong(size, 4);
+}
+
+//! adds a sheet, read by StarObjectSpreadsheet::readSCTable
+static void addCalcTable(StreamBuffer &stream, int sheet, int numRows, int numColumns)
+{
+  stream.addULong(0x4222, 2);
+  size_t tablePos=openSCRecord(stream);
+
+  stream.addULong(0x4242, 2); // tabOptions
+  size_t pos=openSCRecord(stream);
+  char name[20];
+  snprintf(name, sizeof(name), "Sheet%d", sheet+1);
+  stream.addString(name);
+  stream.addULong(0, 1); // scenario
+  stream.addString(""); // comment
+  stream.addULong(0, 1); // protected
+  stream.addString(""); // password
+  stream.addULong(0, 1); // outline
+  closeSCRecord(stream, pos);
+
+  stream.addULong(0x4240, 2); // columns, a ScMultiRecord
+  pos=openSCRecord(stream);
+  std::vector<size_t> columnSizes;
+  for (int column=0; column<numColumns; ++column) {
+    stream.addULong(static_cast<unsigned long>(column), 1);
+    size_t columnPos=stream.tell();
+    addCalcColumnData(stream, sheet, column, numRows);
+    columnSizes.push_back(stream.tell()-columnPos);
+  }
+  closeSCRecord(stream, pos);
+  stream.addULong(0x4200, 2);
+  stream.addULong(4*columnSizes.size(), 4);
+  for (auto size : columnSizes)
+    stream.addULong(size, 4);
+
+  closeSCRecord(stream, tablePos);
+}
+
+//! creates the StarCalcDocument stream, read by StarObjectSpreadsheet::readCalcDocument
+static void createCalcDocument(StreamBuffer &stream, int numSheets, int numRows, int numColumns)
+{
+  stream.addULong(0x422d, 2);
+  size_t docPos=openSCRecord(stream);
+
+  stream.addULong(0x4221, 2); // docFlags
+  size_t pos=openSCRecord(stream);
+  stream.addULong(s_calcVersion, 2);
+  stream.addString("Standard"); // page style
+  stream.addULong(0, 1); // protected
+  stream.addString(""); // password
+  stream.addULong(0x409, 2); // language
+  stream.addULong(1, 1); // autoCalc
+  stream.addULong(0, 2); // visible table
+  stream.addULong(s_calcVersion, 2);
+  stream.addULong(31999, 2); // max row
+  closeSCRecord(stream, pos);
+
+  for (int sheet=0; sheet<numSheets; ++sheet)
+    addCalcTable(stream, sheet, numRows, numColumns);
+  closeSCRecord(stream, docPos);
+}
+
+////////////////////////////////////////////////////////////
+// the text document
+////////////////////////////////////////////////////////////
+
+//! the paragraph styles
+static char const *s_paragraphStyles[]= {"Standard", "Text body", "Heading", "List"};
+
+//! adds a character attribute in a 'S' record, read by StarWriterStruct::Attribute::read
+static void addTextAttribute(StreamBuffer &stream, std::vector<std::pair<size_t, size_t> > &recordSizes,
+                             int which, int version, int begin, int end, unsigned long value, int numBytes)
+{
+  size_t pos=openSWRecord(stream, 'A');
+  stream.addULong(0x38, 1); // flags: has begin, has end, 8 bytes
+  stream.addULong(static_cast<unsigned long>(which), 2);
+  stream.addULong(static_cast<unsigned long>(version), 2);
+  stream.addULong(static_cast<unsigned long>(begin), 2);
+  stream.addULong(static_cast<unsigned long>(end), 2);
+  stream.addULong(value, numBytes);
+  closeSWRecord(stream, pos, recordSizes);
+}
+
+//! adds a paragraph, read by StarObjectText::readSWTextZone
+static void addTextParagraph(StreamBuffer &stream, std::vector<std::pair<size_t, size_t> > &recordSizes, int id)
+{
+  size_t pos=openSWRecord(stream, 'T');
+  stream.addULong(0x04, 1); // flags: 4 bytes
+  stream.addULong(static_cast<unsigned long>(id%4), 2); // the style: an index in the string pool
+  stream.addULong(0xfffe, 2); // nCondColl
+  char text[200];
+  snprintf(text, sizeof(text), "Paragraph %d: Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.", id+1);
+  stream.addString(text);
+  auto length=int(strlen(text));
+
+  size_t listPos=openSWRecord(stream, 'S');
+  // bold on the paragraph number
+  addTextAttribute(stream, recordSizes, 0x100e, 0, 0, 9, 8, 1);
+  if (id%2) // italic
+    addTextAttribute(stream, recordSizes, 0x100a, 0, 10, 20, 2, 1);
+  // a color: 0x8000 followed by the red, green and blue components
+  unsigned long color=0x8000 | (static_cast<unsigned long>(((id*40)%256)<<8)<<16) |
+                      (static_cast<unsigned long>(((id*90)%256)<<8)<<32) | (static_cast<unsigned long>(((id*160)%256)<<8)<<48);
+  addTextAttribute(stream, recordSizes, 0x1002, 0, 20+id%5, 30+id%7, color, 8);
+  // the font size in twips and its proportion
+  addTextAttribute(stream, recordSizes, 0x1007, 1, 30+id%7, length, static_cast<unsigned long>(200+20*(id%5)) | (100UL<<16), 4);
+  closeSWRecord(stream, listPos, recordSizes);
+
+  closeSWRecord(stream, pos, recordSizes);
+}
+
+//! creates the StarWriterDocument stream, read by StarObjectText::readWriterDocument
+static void createWriterDocument(StreamBuffer &stream, int numParagraphs)
+{
+  std::vector<std::pair<size_t, size_t> > recordSizes;
+  // StarZone::readSWHeader
+  stream.addBytes("SW5HDR", 7);
+  stream.addULong(0x2e, 1); // header size
+  stream.addULong(0x217, 2); // document version
+  stream.addULong(0, 2); // file flags
+  stream.addULong(0, 4); // document flags
+  size_t recSizePos=stream.tell();
+  stream.addULong(0, 4); // position of the record sizes
+  stream.addULong(0, 6);
+  stream.addULong(0, 1); // redline
+  stream.addULong(0, 1); // compatibility version
+  stream.addULong(0, 16); // password
+  stream.addULong(1, 1); // the encoding: windows-1252
+  stream.addULong(0, 1);
+  stream.addULong(0, 4); // date
+  stream.addULong(0, 4); // time
+
+  // StarZone::readStringsPool
+  size_t pos=openSWRecord(stream, '!');
+  stream.addULong(1, 1); // the encoding
+  stream.addULong(4, 2);
+  for (auto const *style : s_paragraphStyles) {
+    stream.addULong(0xffff, 2);
+    stream.addString(style);
+  }
+  closeSWRecord(stream, pos, recordSizes);
+
+  // StarObjectText::readSWContent
+  pos=openSWRecord(stream, 'N');
+  stream.addULong(0x04, 1); // flags: 4 bytes
+  stream.addULong(static_cast<unsigned long>(numParagraphs), 4);
+  for (int i=0; i<numParagraphs; ++i)
+    addTextParagraph(stream, recordSizes, i);
+  closeSWRecord(stream, pos, recordSizes);
+
+  pos=openSWRecord(stream, 'Z');
+  closeSWRecord(stream, pos, recordSizes);
+
+  if (recordSizes.empty())
+    return;
+  stream.setULong(recSizePos, stream.tell(), 4);
+  pos=openSWRecord(stream, '%');
+  stream.addULong(0x04, 1); // flags: 4 bytes
+  stream.addULong(recordSizes.size(), 4);
+  for (auto const &size : recordSizes) {
+    stream.addULong(size.first, 4);
+    stream.addULong(size.second, 4);
+  }
+  closeSWRecord(stream, pos, recordSizes);
+}
+
+////////////////////////////////////////////////////////////
+// the drawing
+////////////////////////////////////////////////////////////
+
+//! the version of the drawing records
+static int const s_drawVersion=16;
+
+//! the number of shapes by page
+static int const s_numShapesByPage=64;
+
+/** adds the object header, the attributes and the text part which
+    begin a shape, see StarObjectSmallGraphic::readSVDRObjectText */
+static void addDrawObjectBegin(StreamBuffer &stream, int x, int y, int width, int height)
+{
+  // StarObjectSmallGraphic::readSVDRObjectHeader
+  size_t pos=openRecord(stream);
+  stream.addLong(x, 4);
+  stream.addLong(y, 4);
+  stream.addLong(x+width, 4);
+  stream.addLong(y+height, 4);
+  stream.addULong(0, 2); // layer
+  stream.addLong(x, 4); // anchor
+  stream.addLong(y, 4);
+  stream.addULong(0, 6); // flags
+  stream.addULong(0, 1); // no glue points
+  stream.addULong(0, 1); // no user data
+  closeRecord(stream, pos);
+
+  // StarObjectSmallGraphic::readSVDRObjectAttrib: no line, fill, text, shadow, outliner and misc attributes
+  pos=openRecord(stream);
+  for (int i=0; i<6; ++i)
+    stream.addULong(0xfff0, 2);
+  stream.addString(""); // the style
+  closeRecord(stream, pos);
+
+  // StarObjectSmallGraphic::readSVDRObjectText
+  pos=openRecord(stream);
+  stream.addULong(0, 1); // text kind
+  stream.addLong(x, 4);
+  stream.addLong(y, 4);
+  stream.addLong(x+width, 4);
+  stream.addLong(y+height, 4);
+  stream.addULong(0, 4); // rotation
+  stream.addULong(0, 4); // shear
+  stream.addULong(0, 1); // no paragraph object
+  stream.addULong(0, 1); // no bound
+  closeRecord(stream, pos);
+}
+
+//! adds a polygon, see StarObjectSmallGraphic::readSVDRObjectPath
+static void addDrawPolygon(StreamBuffer &stream, int id, int x, int y, int size)
+{
+  size_t pos=openSDRHeader(stream, "DrOb", s_drawVersion);
+  stream.addBytes("SVDr", 4);
+  stream.addULong(11, 2); // path fill
+  addDrawObjectBegin(stream, x, y, size, size);
+  size_t pathPos=openRecord(stream);
+  size_t polyPos=openRecord(stream);
+  stream.addULong(1, 2);
+  int const numPoints=8+2*(id%8);
+  stream.addULong(static_cast<unsigned long>(numPoints), 2);
+  for (int pt=0; pt<numPoints; ++pt) {
+    // a star: the odd points are nearer of the center
+    double const angle=6.283185307179586*pt/numPoints;
+    int radius=(pt%2) ? size/4 : size/2;
+    stream.addLong(x+size/2+int(radius*cos(angle)), 4);
+    stream.addLong(y+size/2+int(radius*sin(angle)), 4);
+  }
+  for (int pt=0; pt<numPoints; ++pt)
+    stream.addULong(0, 1); // normal point
+  closeRecord(stream, polyPos);
+  closeRecord(stream, pathPos);
+  closeSDRHeader(stream, pos);
+}
+
+//! adds a 24 bits bitmap, see StarObjectSmallGraphic::readSVDRObjectGraph and StarBitmap::readBitmap
+static void addDrawBitmap(StreamBuffer &stream, int id, int x, int y, int size, int bitmapSize)
+{
+  size_t pos=openSDRHeader(stream, "DrOb", s_drawVersion);
+  stream.addBytes("SVDr", 4);
+  stream.addULong(22, 2); // graphic
+  addDrawObjectBegin(stream, x, y, size, size);
+  size_t rectPos=openRecord(stream);
+  closeRecord(stream, rectPos);
+
+  size_t graphPos=openRecord(stream);
+  stream.addULong(1, 1); // has graphic
+  size_t bitmapPos=openRecord(stream);
+  auto const rowSize=static_cast<unsigned long>((3*bitmapSize+3)/4*4);
+  auto const dataSize=rowSize*static_cast<unsigned long>(bitmapSize);
+  stream.addBytes("BM", 2);
+  stream.addULong(54+dataSize, 4);
+  stream.addULong(0, 4);
+  stream.addULong(54, 4); // the offset of the pixels
+  stream.addULong(40, 4); // the info header size
+  stream.addULong(static_cast<unsigned long>(bitmapSize), 4);
+  stream.addULong(static_cast<unsigned long>(bitmapSize), 4);
+  stream.addULong(1, 2); // planes
+  stream.addULong(24, 2); // bit count
+  stream.addULong(0, 4); // no compression
+  stream.addULong(dataSize, 4);
+  stream.addULong(2835, 4); // 72 dpi
+  stream.addULong(2835, 4);
+  stream.addULong(0, 4); // colors
+  stream.addULong(0, 4);
+  for (int row=0; row<bitmapSize; ++row) {
+    size_t rowPos=stream.tell();
+    for (int col=0; col<bitmapSize; ++col) {
+      stream.addULong(static_cast<unsigned long>((col*255)/bitmapSize), 1);
+      stream.addULong(static_cast<unsigned long>((row*255)/bitmapSize), 1);
+      stream.addULong(static_cast<unsigned long>((id*37)%256), 1);
+    }
+    stream.addULong(0, int(rowSize-(stream.tell()-rowPos)));
+  }
+  closeRecord(stream, bitmapPos);
+  stream.addLong(0, 4); // the graphic rectangle
+  stream.addLong(0, 4);
+  stream.addLong(bitmapSize, 4);
+  stream.addLong(bitmapSize, 4);
+  stream.addULong(0, 1); // mirrored
+  for (int i=0; i<3; ++i)
+    stream.addString(""); // the graphic, file and filter names
+  stream.addULong(0, 1); // no link
+  closeRecord(stream, graphPos);
+  closeSDRHeader(stream, pos);
+}
+
+/** adds a page or a master page, read by StarObjectModel::readSdrPage: the
+    pages use the master page 1, the first standard master page (the master
+    page 0 is the handout master page) */
+static void addDrawPage(StreamBuffer &stream, bool master, int firstShape, int numShapes, int bitmapSize)
+{
+  size_t pos=openSDRHeader(stream, master ? "DrMP" : "DrPg", s_drawVersion);
+  size_t dataPos=openRecord(stream);
+  stream.addBytes("JoeM", 4);
+  size_t dimPos=openRecord(stream);
+  stream.addLong(21000, 4); // A4 in 1/100 mm
+  stream.addLong(29700, 4);
+  for (int i=0; i<4; ++i)
+    stream.addLong(1000, 4); // the borders
+  stream.addULong(0, 2);
+  closeRecord(stream, dimPos);
+  if (!master) {
+    // StarObjectModel::readSdrMPageDescList
+    size_t listPos=openSDRHeader(stream, "DrML", s_drawVersion);
+    stream.addULong(1, 2);
+    size_t descPos=openSDRHeader(stream, "DrMD", s_drawVersion);
+    stream.addULong(1, 2); // the master page id
+    for (int i=0; i<32; ++i)
+      stream.addULong(0xff, 1); // the visible layers
+    closeSDRHeader(stream, descPos);
+    closeSDRHeader(stream, listPos);
+  }
+  for (int i=0; i<numShapes; ++i) {
+    int const id=firstShape+i;
+    // a grid of 8x8 shapes of 2cm
+    int const x=1000+2300*(i%8), y=1000+3400*(i/8);
+    if (id%4==3)
+      addDrawBitmap(stream, id, x, y, 2000, bitmapSize);
+    else
+      addDrawPolygon(stream, id, x, y, 2000);
+  }
+  stream.addBytes("DrXX", 4);
+  stream.addULong(0, 1); // no background
+  closeRecord(stream, dataPos);
+  closeSDRHeader(stream, pos);
+}
+
+//! creates the StarDrawDocument3 stream, read by StarObjectModel::read
+static void createDrawDocument(StreamBuffer &stream, int numShapes, int bitmapSize)
+{
+  size_t pos=openSDRHeader(stream, "DrMd", s_drawVersion);
+  size_t dataPos=openRecord(stream);
+  stream.addBytes("JoeM", 4);
+  size_t modelPos=openRecord(stream);
+  size_t infoPos=openRecord(stream);
+  for (int i=0; i<3; ++i) { // creation, modification and last read: date, time, encoding, system
+    stream.addULong(0, 8);
+    stream.addULong(1, 1);
+    stream.addULong(0, 3);
+  }
+  stream.addULong(0, 8); // last print
+  closeRecord(stream, infoPos);
+  size_t statPos=openRecord(stream);
+  closeRecord(stream, statPos);
+  size_t compatPos=openRecord(stream);
+  stream.addULong(0, 2); // not compressed
+  stream.addULong(0xffff, 2); // number format
+  closeRecord(stream, compatPos);
+  stream.addLong(1, 4); // the object unit
+  stream.addLong(1, 4);
+  stream.addULong(0, 2);
+  stream.addULong(0, 2);
+  stream.addULong(0, 1); // page valid
+  stream.addULong(0, 1);
+  for (int i=0; i<6; ++i)
+    stream.addString(""); // the table, dash, line end, hatch, gradient and bitmap names
+  stream.addLong(1, 4); // the UI unit
+  stream.addLong(1, 4);
+  stream.addULong(0, 2);
+  stream.addLong(0, 4); // default text height
+  stream.addLong(0, 4); // default tab
+  stream.addULong(0xffff, 2); // no preview page
+  closeRecord(stream, modelPos);
+
+  for (int i=0; i<2; ++i) // the handout and the standard master pages
+    addDrawPage(stream, true, 0, 0, bitmapSize);
+  for (int shape=0; shape<numShapes; shape+=s_numShapesByPage)
+    addDrawPage(stream, false, shape, numShapes-shape<s_numShapesByPage ? numShapes-shape : s_numShapesByPage, bitmapSize);
+  closeRecord(stream, dataPos);
+  closeSDRHeader(stream, pos);
+}
+
+////////////////////////////////////////////////////////////
+// the OLE file
+////////////////////////////////////////////////////////////
+
+/** writes an OLE compound file (version 3, sectors of 512 bytes) which
+    contains only a stream, the streams smaller than 4096 bytes are
+    stored in the mini stream */
+static bool writeOLEFile(char const *path, std::string const &streamName, unsigned char const (&clsid)[16],
+                         std::vector<unsigned char> const &data)
+{
+  unsigned long const endOfChain=0xfffffffe, freeSector=0xffffffff;
+  unsigned long const streamSize=static_cast<unsigned long>(data.size());
+  bool const isSmall=streamSize<4096;
+  // the number of sectors used by the mini FAT, the mini stream and the stream
+  unsigned long const numMiniSectors=isSmall ? (streamSize+63)/64 : 0;
+  unsigned long const numMiniFATSectors=(numMiniSectors*4+511)/512;
+  unsigned long const numDataSectors=isSmall ? (numMiniSectors*64+511)/512 : (streamSize+511)/512;
+  unsigned long numFATSectors=1, numDIFATSectors=0;
+  while (true) {
+    unsigned long numSectors=numFATSectors+numDIFATSectors+1+numMiniFATSectors+numDataSectors;
+    unsigned long newFAT=(numSectors+127)/128;
+    unsigned long newDIFAT=newFAT>109 ? (newFAT-109+126)/127 : 0;
+    if (newFAT==numFATSectors && newDIFAT==numDIFATSectors) break;
+    numFATSectors=newFAT;
+    numDIFATSectors=newDIFAT;
+  }
+  unsigned long const firstDIFAT=numFATSectors, dirSector=firstDIFAT+numDIFATSectors;
+  unsigned long const firstMiniFAT=dirSector+1, firstData=firstMiniFAT+numMiniFATSectors;
+  unsigned long const numSectors=firstData+numDataSectors;
+
+  StreamBuffer file;
+  // the header
+  file.addBytes("\xd0\xcf\x11\xe0\xa1\xb1\x1a\xe1", 8);
+  file.addULong(0, 16);
+  file.addULong(0x3e, 2);
+  file.addULong(3, 2);
+  file.addULong(0xfffe, 2); // little endian
+  file.addULong(9, 2); // sector: 512 bytes
+  file.addULong(6, 2); // mini sector: 64 bytes
+  file.addULong(0, 6);
+  file.addULong(0, 4);
+  file.addULong(numFATSectors, 4);
+  file.addULong(dirSector, 4);
+  file.addULong(0, 4);
+  file.addULong(4096, 4); // mini stream cutoff
+  file.addULong(numMiniFATSectors ? firstMiniFAT : endOfChain, 4);
+  file.addULong(numMiniFATSectors, 4);
+  file.addULong(numDIFATSectors ? firstDIFAT : endOfChain, 4);
+  file.addULong(numDIFATSectors, 4);
+  for (unsigned long i=0; i<109; ++i)
+    file.addULong(i<numFATSectors ? i : freeSector, 4);
+
+  // the FAT
+  for (unsigned long s=0; s<numFATSectors*128; ++s) {
+    if (s<firstDIFAT)
+      file.addULong(0xfffffffd, 4);
+    else if (s<dirSector)
+      file.addULong(0xfffffffc, 4);
+    else if (s==dirSector)
+      file.addULong(endOfChain, 4);
+    else if (s<numSectors)
+      file.addULong((s+1==firstData || s+1==numSectors) ? endOfChain : s+1, 4);
+    else
+      file.addULong(freeSector, 4);
+  }
+  // the DIFAT: 127 FAT sectors followed by the next DIFAT sector
+  for (unsigned long d=0; d<numDIFATSectors; ++d) {
+    for (unsigned long i=0; i<127; ++i) {
+      unsigned long fat=109+127*d+i;
+      file.addULong(fat<numFATSectors ? fat : freeSector, 4);
+    }
+    file.addULong(d+1<numDIFATSectors ? firstDIFAT+d+1 : endOfChain, 4);
+  }
+
+  // the directory: the root and the stream
+  for (int entry=0; entry<4; ++entry) {
+    size_t pos=file.tell();
+    std::string name=entry==0 ? "Root Entry" : entry==1 ? streamName : "";
+    for (auto c : name)
+      file.addULong(static_cast<unsigned char>(c), 2);
+    file.addULong(0, int(64-(file.tell()-pos)));
+    file.addULong(name.empty() ? 0 : 2*(name.size()+1), 2);
+    file.addULong(entry==0 ? 5 : entry==1 ? 2 : 0, 1); // root, stream or empty
+    file.addULong(entry<2 ? 1 : 0, 1); // black
+    file.addULong(freeSector, 4); // left
+    file.addULong(freeSector, 4); // right
+    file.addULong(entry==0 ? 1 : freeSector, 4); // child
+    if (entry==0)
+      file.addBytes(reinterpret_cast<char const *>(clsid), 16);
+    else
+      file.addULong(0, 16);
+    file.addULong(0, 4); // state
+    file.addULong(0, 16); // creation and modification times
+    if (entry==0) {
+      file.addULong(isSmall ? firstData : endOfChain, 4);
+      file.addULong(numMiniSectors*64, 4);
+    }
+    else if (entry==1) {
+      file.addULong(isSmall ? 0 : firstData, 4);
+      file.addULong(streamSize, 4);
+    }
+    else
+      file.addULong(0, 8);
+    file.addULong(0, 4);
+  }
+  // the mini FAT
+  for (unsigned long s=0; s<numMiniFATSectors*128; ++s)
+    file.addULong(s<numMiniSectors ? (s+1==numMiniSectors ? endOfChain : s+1) : freeSector, 4);
+
+  FILE *output=fopen(path, "wb");
+  if (!output) return false;
+  bool ok=fwrite(file.m_data.data(), 1, file.m_data.size(), output)==file.m_data.size() &&
+          fwrite(data.data(), 1, data.size(), output)==data.size();
+  // fills the last sector
+  std::vector<unsigned char> padding(size_t(512*(numSectors+1))-file.m_data.size()-data.size(), 0);
+  if (ok && !padding.empty())
+    ok=fwrite(padding.data(), 1, padding.size(), output)==padding.size();
+  return fclose(output)==0 && ok;
+}
+
+////////////////////////////////////////////////////////////
+// the checks: parses the created file with the library
+////////////////////////////////////////////////////////////
+
+//! a callback used to count the sheets and the cells of a spreadsheet
+class CellCounter final : public STOFFDocument::ColumnCallback
+{
+public:
+  //! constructor
+  CellCounter()
+    : m_numSheets(0)
+    , m_numCells()
+  {
+  }
+  //! count the non empty cells of a column
+  void insertColumn(int sheet, librevenge::RVNGString const &/*sheetName*/, STOFFDocument::SpreadsheetColumn const &column) final
+  {
+    if (sheet>=m_numSheets) m_numSheets=sheet+1;
+    for (unsigned long i=0; i<column.m_numRows; ++i) {
+      if (column.m_types[i]!=STOFFDocument::SpreadsheetColumn::C_EMPTY)
+        ++m_numCells[column.m_types[i]];
+    }
+  }
+  //! the number of sheets
+  int m_numSheets;
+  //! the number of cells by type
+  unsigned long m_numCells[4];
+};
+
+//! a callback used to count the paragraphs of a text document
+class ParagraphCounter final : public STOFFDocument::ParagraphCallback
+{
+public:
+  //! constructor
+  ParagraphCounter()
+    : m_numParagraphs(0)
+    , m_numBadParagraphs(0)
+  {
+  }
+  //! count the paragraph and check its beginning
+  void insertParagraph(librevenge::RVNGString const &text) final
+  {
+    char begin[30];
+    snprintf(begin, sizeof(begin), "Paragraph %d:", ++m_numParagraphs);
+    if (strncmp(text.cstr(), begin, strlen(begin))!=0)
+      ++m_numBadParagraphs;
+  }
+  //! the number of paragraphs
+  int m_numParagraphs;
+  //! the number of paragraphs whose text is not the expected one
+  int m_numBadParagraphs;
+};
+
+/** parses the created file and checks its number of cells, paragraphs or
+    pages, returns false and prints an error if the parsing fails or if the
+    numbers differ */
+static bool checkDocument(char const *path, char const *type, int num, int numRows, int numColumns)
+{
+  librevenge::RVNGFileStream input(path);
+  STOFFDocument::Result error=STOFFDocument::STOFF_R_OK;
+  if (strcmp(type, "calc")==0) {
+    CellCounter counter;
+    error=STOFFDocument::parseSpreadsheetColumns(&input, counter);
+    unsigned long const numCellsByType=static_cast<unsigned long>(num)*static_cast<unsigned long>(numRows)*
+                                       static_cast<unsigned long>(numColumns/3);
+    int const extra=numColumns%3;
+    unsigned long const numValues=numCellsByType+(extra>0 ? static_cast<unsigned long>(num*numRows) : 0);
+    unsigned long const numTexts=numCellsByType+(extra>1 ? static_cast<unsigned long>(num*numRows) : 0);
+    if (error==STOFFDocument::STOFF_R_OK && (counter.m_numSheets!=num ||
+        counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_NUMBER]!=numValues ||
+        counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_TEXT]!=numTexts ||
+        counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_FORMULA]!=numCellsByType)) {
+      fprintf(stderr, "ERROR: %s: find %d sheets and %lu/%lu/%lu values/texts/formulas, expected %d and %lu/%lu/%lu\n", path,
+              counter.m_numSheets, counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_NUMBER],
+              counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_TEXT],
+              counter.m_numCells[STOFFDocument::SpreadsheetColumn::C_FORMULA], num, numValues, numTexts, numCellsByType);
+      return false;
+    }
+  }
+  else if (strcmp(type, "text")==0) {
+    ParagraphCounter counter;
+    error=STOFFDocument::parseText(&input, counter);
+    if (error==STOFFDocument::STOFF_R_OK && (counter.m_numParagraphs!=num || counter.m_numBadParagraphs)) {
+      fprintf(stderr, "ERROR: %s: find %d paragraphs (%d with an unexpected text), expected %d\n", path,
+              counter.m_numParagraphs, counter.m_numBadParagraphs, num);
+      return false;
+    }
+  }
+  else {
+    librevenge::RVNGStringVector pages;
+    librevenge::RVNGSVGDrawingGenerator listener(pages, "");
+    error=STOFFDocument::parse(&input, &listener);
+    int const numPages=(num+s_numShapesByPage-1)/s_numShapesByPage;
+    if (error==STOFFDocument::STOFF_R_OK && int(pages.size())!=numPages) {
+      fprintf(stderr, "ERROR: %s: find %d pages, expected %d\n", path, int(pages.size()), numPages);
+      return false;
+    }
+  }
+  if (error!=STOFFDocument::STOFF_R_OK) {
+    fprintf(stderr, "ERROR: %s: can not parse the file, error=%d\n", path, int(error));
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  bool printHelp=false, check=false;
+  char const *type=nullptr;
+  int num=-1, numRows=1000, numColumns=16, bitmapSize=32;
+  int ch;
+
+  while ((ch = getopt(argc, argv, "b:c:hn:r:t:v")) != -1) {
+    switch (ch) {
+    case 'b':
+      bitmapSize=atoi(optarg);
+      break;
+    case 'c':
+      numColumns=atoi(optarg);
+      break;
+    case 'n':
+      num=atoi(optarg);
+      break;
+    case 'r':
+      numRows=atoi(optarg);
+      break;
+    case 't':
+      type=optarg;
+      break;
+    case 'v':
+      check=true;
+      break;
+    default:
+    case 'h':
+      printHelp = true;
+      break;
+    }
+  }
+  if (argc != optind+1 || !type || printHelp || num==0 || num<-1 || numRows<=0 || numRows>32000 ||
+      numColumns<=0 || numColumns>256 || bitmapSize<=0 || bitmapSize>4096) {
+    printUsage();
+    return -1;
+  }
+
+  StreamBuffer stream;
+  std::string streamName;
+  if (strcmp(type, "calc")==0) {
+    static unsigned char const clsid[]= {0x61,0xb8,0xa5,0xc6,0xd6,0x85,0xd1,0x11,0x89,0xcb,0x00,0x80,0x29,0xe4,0xb0,0xb1};
+    if (num<0) num=1;
+    createCalcDocument(stream, num, numRows, numColumns);
+    if (!writeOLEFile(argv[optind], "StarCalcDocument", clsid, stream.m_data)) {
+      fprintf(stderr, "ERROR: can not write %s\n", argv[optind]);
+      return 1;
+    }
+  }
+  else if (strcmp(type, "text")==0) {
+    static unsigned char const clsid[]= {0xd1,0xf9,0x0c,0xc2,0xae,0x85,0xd1,0x11,0xaa,0xb4,0x00,0x60,0x97,0xda,0x56,0x1a};
+    if (num<0) num=1000;
+    createWriterDocument(stream, num);
+    if (!writeOLEFile(argv[optind], "StarWriterDocument", clsid, stream.m_data)) {
+      fprintf(stderr, "ERROR: can not write %s\n", argv[optind]);
+      return 1;
+    }
+  }
+  else if (strcmp(type, "draw")==0) {
+    static unsigned char const clsid[]= {0xa0,0x05,0x89,0x2e,0xbd,0x85,0xd1,0x11,0x89,0xd0,0x00,0x80,0x29,0xe4,0xb0,0xb1};
+    if (num<0) num=100;
+    createDrawDocument(stream, num, bitmapSize);
+    if (!writeOLEFile(argv[optind], "StarDrawDocument3", clsid, stream.m_data)) {
+      fprintf(stderr, "ERROR: can not write %s\n", argv[optind]);
+      return 1;
+    }
+  }
+  else {
+    printUsage();
+    return -1;
+  }
+  if (check && !checkDocument(argv[optind], type, num, numRows, numColumns))
+    return 1;
+  return 0;
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -30,10 +30,15 @@
 * instead of those above.
 */
 
+#include <getopt.h>
 #include <stdio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
@@ -62,14 +67,172 @@ static int printUsage()
   printf("\n");
   printf("Options:\n");
   printf("\t-c                 display the call graph nesting level\n");
+  printf("\t-d                 only detect the file format: compare the fast and the complete detection\n");
   printf("\t-h                 show this help message\n");
   printf("\t-p PASSWORD        set password to open the file\n");
+  printf("\t--profile          print the time and the size of each record type and the big allocations\n");
+  printf("\t-s RECORDS         skip some ignorable records of a text document, for instance UVMjd,\n");
+  printf("\t                   and print the number of skipped bytes and the parsing time\n");
   printf("\t-v                 show version information\n");
   printf("\n");
   printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
   return 0;
 }
 
+/** a small input stream which counts the number of bytes read by the library,
+    ie. the bytes read from the file and the size of the created sub-streams */
+class CountingInputStream final : public librevenge::RVNGInputStream
+{
+public:
+  explicit CountingInputStream(librevenge::RVNGInputStream &input)
+    : librevenge::RVNGInputStream()
+    , m_input(input)
+    , m_numBytesRead(0)
+  {
+  }
+  bool isStructured() final
+  {
+    return m_input.isStructured();
+  }
+  unsigned subStreamCount() final
+  {
+    return m_input.subStreamCount();
+  }
+  const char *subStreamName(unsigned id) final
+  {
+    return m_input.subStreamName(id);
+  }
+  bool existsSubStream(const char *name) final
+  {
+    return m_input.existsSubStream(name);
+  }
+  librevenge::RVNGInputStream *getSubStreamByName(const char *name) final
+  {
+    return count(m_input.getSubStreamByName(name));
+  }
+  librevenge::RVNGInputStream *getSubStreamById(unsigned id) final
+  {
+    return count(m_input.getSubStreamById(id));
+  }
+  const unsigned char *read(unsigned long numBytes, unsigned long &numBytesRead) final
+  {
+    auto res=m_input.read(numBytes, numBytesRead);
+    m_numBytesRead+=numBytesRead;
+    return res;
+  }
+  int seek(long offset, librevenge::RVNG_SEEK_TYPE seekType) final
+  {
+    return m_input.seek(offset, seekType);
+  }
+  long tell() final
+  {
+    return m_input.tell();
+  }
+  bool isEnd() final
+  {
+    return m_input.isEnd();
+  }
+  unsigned long getNumBytesRead() const
+  {
+    return m_numBytesRead;
+  }
+private:
+  librevenge::RVNGInputStream *count(librevenge::RVNGInputStream *stream)
+  {
+    if (!stream) return stream;
+    long pos=stream->tell();
+    if (stream->seek(0, librevenge::RVNG_SEEK_END)==0)
+      m_numBytesRead+=static_cast<unsigned long>(stream->tell());
+    stream->seek(pos, librevenge::RVNG_SEEK_SET);
+    return stream;
+  }
+  CountingInputStream(CountingInputStream const &) = delete;
+  CountingInputStream &operator=(CountingInputStream const &) = delete;
+  librevenge::RVNGInputStream &m_input;
+  unsigned long m_numBytesRead;
+};
+
+/** a profile callback which stores the records and the allocations
+    and prints them sorted by decreasing time and size */
+class PrintProfile final : public STOFFDocument::ProfileCallback
+{
+public:
+  //! a record or an allocation
+  struct Entry {
+    //! the name
+    std::string m_name;
+    //! the number of calls
+    unsigned long m_count;
+    //! the total size
+    unsigned long m_size;
+    //! the total time
+    double m_time;
+  };
+  PrintProfile()
+    : STOFFDocument::ProfileCallback()
+    , m_records()
+    , m_allocations()
+  {
+  }
+  void insertRecord(char const *name, unsigned long count, unsigned long numBytes, double seconds) final
+  {
+    m_records.push_back(Entry{name ? name : "", count, numBytes, seconds});
+  }
+  void insertAllocation(char const *subsystem, unsigned long count, unsigned long numBytes) final
+  {
+    m_allocations.push_back(Entry{subsystem ? subsystem : "", count, numBytes, 0});
+  }
+  void print()
+  {
+    std::sort(m_records.begin(), m_records.end(), [](Entry const &a, Entry const &b) {
+      return a.m_time>b.m_time;
+    });
+    fprintf(stderr, "%-40s %10s %12s %12s\n", "record", "count", "bytes", "time(ms)");
+    for (auto const &rec : m_records)
+      fprintf(stderr, "%-40s %10lu %12lu %12.3f\n", rec.m_name.c_str(), rec.m_count, rec.m_size, 1000*rec.m_time);
+    if (m_allocations.empty()) return;
+    std::sort(m_allocations.begin(), m_allocations.end(), [](Entry const &a, Entry const &b) {
+      return a.m_size>b.m_size;
+    });
+    fprintf(stderr, "\n%-40s %10s %12s\n", "allocation", "count", "bytes");
+    for (auto const &alloc : m_allocations)
+      fprintf(stderr, "%-40s %10lu %12lu\n", alloc.m_name.c_str(), alloc.m_count, alloc.m_size);
+  }
+private:
+  //! the records
+  std::vector<Entry> m_records;
+  //! the allocations
+  std::vector<Entry> m_allocations;
+};
+
+static int detect(char const *file)
+{
+  static char const *wh[]= {"unknown", "bitmap", "chart", "database", "draw", "math", "presentation", "spreadsheet", "text", "graphic"};
+  for (int step=0; step<2; ++step) {
+    librevenge::RVNGFileStream fileInput(file);
+    CountingInputStream input(fileInput);
+    STOFFDocument::Kind kind=STOFFDocument::STOFF_K_UNKNOWN;
+    int version=0;
+    auto confidence = STOFFDocument::STOFF_C_NONE;
+    auto start=std::chrono::steady_clock::now();
+    try {
+      if (step==0)
+        confidence = STOFFDocument::isFileFormatSupportedFast(&input, kind, version);
+      else
+        confidence = STOFFDocument::isFileFormatSupported(&input, kind);
+    }
+    catch (...) {
+      confidence = STOFFDocument::STOFF_C_NONE;
+    }
+    auto duration=std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start).count();
+    printf("%s: %s", step==0 ? "fast" : "complete", confidence==STOFFDocument::STOFF_C_NONE ? "unsupported" : wh[int(kind)]);
+    if (step==0 && confidence!=STOFFDocument::STOFF_C_NONE) printf(", version=%d", version);
+    if (confidence==STOFFDocument::STOFF_C_SUPPORTED_ENCRYPTION) printf(", encrypted");
+    printf(", read=%lu bytes, time=%ld us\n", input.getNumBytesRead(), long(duration));
+  }
+  return 0;
+}
+
 static int printVersion()
 {
   printf("%s %s\n", TOOLNAME, VERSION);
@@ -78,22 +241,36 @@ static int printVersion()
 
 int main(int argc, char *argv[])
 {
-  bool printIndentLevel = false, printHelp = false;
+  bool printIndentLevel = false, printHelp = false, onlyDetect = false, profile = false;
   char *file = nullptr;
   char const *password=nullptr;
+  STOFFDocument::ParseOptions options;
   int ch;
 
-  while ((ch = getopt(argc, argv, "chvp:")) != -1) {
+  static struct option const longOptions[]= {
+    {"profile", no_argument, nullptr, 'P'},
+    {nullptr, 0, nullptr, 0}
+  };
+  while ((ch = getopt_long(argc, argv, "cdhvp:s:", longOptions, nullptr)) != -1) {
     switch (ch) {
+    case 'P':
+      profile = true;
+      break;
     case 'c':
       printIndentLevel = true;
       break;
+    case 'd':
+      onlyDetect = true;
+      break;
     case 'v':
       printVersion();
       return 0;
     case 'p':
       password=optarg;
       break;
+    case 's':
+      options.m_skippedTextRecords=optarg;
+      break;
     default:
     case 'h':
       printHelp = true;
@@ -106,6 +283,8 @@ int main(int argc, char *argv[])
   }
 
   file=argv[optind];
+  if (onlyDetect)
+    return detect(file);
   librevenge::RVNGFileStream input(file);
 
   STOFFDocument::Kind kind;
@@ -121,23 +300,30 @@ int main(int argc, char *argv[])
     return 1;
   }
 
+  PrintProfile printProfile;
+  if (profile)
+    options.m_profileCallback=&printProfile;
+  unsigned long numSkippedBytes=0;
+  if (options.m_skippedTextRecords)
+    options.m_skippedTextBytes=&numSkippedBytes;
   auto error = STOFFDocument::STOFF_R_OK;
+  auto start=std::chrono::steady_clock::now();
   try {
     if (kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC) {
       librevenge::RVNGRawDrawingGenerator documentGenerator(printIndentLevel);
-      error=STOFFDocument::parse(&input, &documentGenerator,password);
+      error=STOFFDocument::parse(&input, &documentGenerator,options,password);
     }
     else if (kind == STOFFDocument::STOFF_K_SPREADSHEET || kind == STOFFDocument::STOFF_K_DATABASE) {
       librevenge::RVNGRawSpreadsheetGenerator documentGenerator(printIndentLevel);
-      error=STOFFDocument::parse(&input, &documentGenerator,password);
+      error=STOFFDocument::parse(&input, &documentGenerator,options,password);
     }
     else if (kind == STOFFDocument::STOFF_K_PRESENTATION) {
       librevenge::RVNGRawPresentationGenerator documentGenerator(printIndentLevel);
-      error=STOFFDocument::parse(&input, &documentGenerator,password);
+      error=STOFFDocument::parse(&input, &documentGenerator,options,password);
     }
     else {
       librevenge::RVNGRawTextGenerator documentGenerator(printIndentLevel);
-      error=STOFFDocument::parse(&input, &documentGenerator,password);
+      error=STOFFDocument::parse(&input, &documentGenerator,options,password);
     }
   }
   catch (STOFFDocument::Result const &err) {
@@ -146,6 +332,12 @@ int main(int argc, char *argv[])
   catch (...) {
     error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
   }
+  if (options.m_skippedTextRecords) {
+    auto duration=std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start).count();
+    fprintf(stderr, "skipped records %s: %lu bytes, time=%ld us\n", options.m_skippedTextRecords, numSkippedBytes, long(duration));
+  }
+  if (profile)
+    printProfile.print();
 
   if (error == STOFFDocument::STOFF_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
@@ -41,6 +41,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
@@ -69,12 +70,61 @@ static int printUsage()
   printf("\t-o OUTPUT          write ouput to OUTPUT\n");
   printf("\t-N                 Output the number of sheets\n");
   printf("\t-n NUM             choose the page to convert (1: means first page)\n");
+  printf("\t-p FIRST[-LAST]    convert only the pages FIRST to LAST, each page is written in\n");
+  printf("\t                   OUTPUT-NUM.svg (or in the standard output if no output is given)\n");
   printf("\t-v                 show version information\n");
   printf("\n");
   printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
   return -1;
 }
 
+static void writeSVG(std::ostream &out, librevenge::RVNGString const &page)
+{
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+  out << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
+  out << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
+  out << page.cstr() << std::endl;
+}
+
+//! returns the name of the file used to store a page: OUTPUT-NUM.svg
+static std::string getPageFileName(char const *output, int page)
+{
+  std::string name(output);
+  auto dotPos=name.rfind('.');
+  auto slashPos=name.rfind('/');
+  if (dotPos!=std::string::npos && (slashPos==std::string::npos || dotPos>slashPos))
+    name=name.substr(0, dotPos);
+  std::stringstream s;
+  s << name << "-" << page << ".svg";
+  return s.str();
+}
+
+//! converts a drawing or a presentation using some options
+static STOFFDocument::Result convert(char const *fileName, bool isPresentation, STOFFDocument::ParseOptions const &options, librevenge::RVNGStringVector &pages)
+{
+  try {
+    librevenge::RVNGFileStream input(fileName);
+    auto error=STOFFDocument::STOFF_R_OK;
+    if (isPresentation) {
+      librevenge::RVNGSVGPresentationGenerator listener(pages);
+      error = STOFFDocument::parse(&input, &listener, options);
+    }
+    else {
+      librevenge::RVNGSVGDrawingGenerator listener(pages, "");
+      error = STOFFDocument::parse(&input, &listener, options);
+    }
+    if (error==STOFFDocument::STOFF_R_OK && (pages.empty() || pages[0].empty()))
+      error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+    return error;
+  }
+  catch (STOFFDocument::Result const &err) {
+    return err;
+  }
+  catch (...) {
+  }
+  return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+}
+
 static int printVersion()
 {
   printf("%s %s\n", TOOLNAME, VERSION);
@@ -90,8 +140,9 @@ int main(int argc, char *argv[])
   bool printHelp=false;
   bool printNumberOfPages=false;
   int ch, pageToConvert=0;
+  int pageRange[2]= {0,0};
 
-  while ((ch = getopt(argc, argv, "ho:n:vN")) != -1) {
+  while ((ch = getopt(argc, argv, "ho:n:p:vN")) != -1) {
     switch (ch) {
     case 'o':
       output=optarg;
@@ -102,6 +153,14 @@ int main(int argc, char *argv[])
     case 'n':
       pageToConvert=std::atoi(optarg);
       break;
+    case 'p': {
+      char *end=nullptr;
+      pageRange[0]=int(std::strtol(optarg, &end, 10));
+      pageRange[1]=(end && *end=='-') ? std::atoi(end+1) : pageRange[0];
+      if (pageRange[0]<=0 || (pageRange[1]>0 && pageRange[1]<pageRange[0]))
+        printHelp=true;
+      break;
+    }
     case 'N':
       printNumberOfPages=true;
       break;
@@ -131,30 +190,30 @@ int main(int argc, char *argv[])
     fprintf(stderr,"ERROR: Unsupported file format!\n");
     return 1;
   }
-  auto error=STOFFDocument::STOFF_R_OK;
   librevenge::RVNGStringVector vec;
-
-  try {
-    if (kind == STOFFDocument::STOFF_K_DRAW) {
-      librevenge::RVNGSVGDrawingGenerator listener(vec, "");
-      error = STOFFDocument::parse(&input, &listener);
-    }
-    else if (kind == STOFFDocument::STOFF_K_PRESENTATION) {
-      librevenge::RVNGSVGPresentationGenerator listener(vec);
-      error = STOFFDocument::parse(&input, &listener);
-    }
-    else {
-      fprintf(stderr,"ERROR: not a graphic/presentation document!\n");
-      return 1;
-    }
-    if (error==STOFFDocument::STOFF_R_OK && (vec.empty() || vec[0].empty()))
-      error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  bool useRange=pageRange[0]>0;
+  STOFFDocument::ParseOptions options;
+  if (useRange) {
+    options.m_firstPage=pageRange[0];
+    options.m_lastPage=pageRange[1];
   }
-  catch (STOFFDocument::Result const &err) {
-    error=err;
+  else if (pageToConvert>0 && !printNumberOfPages) {
+    // only convert the selected page
+    options.m_firstPage=options.m_lastPage=pageToConvert;
+    pageToConvert=1;
   }
-  catch (...) {
-    error=STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+
+  if (kind != STOFFDocument::STOFF_K_DRAW && kind != STOFFDocument::STOFF_K_PRESENTATION) {
+    fprintf(stderr,"ERROR: not a graphic/presentation document!\n");
+    return 1;
+  }
+  bool const isPresentation=kind == STOFFDocument::STOFF_K_PRESENTATION;
+  int numPages=0;
+  options.m_numPages=&numPages;
+  auto error = convert(argv[optind], isPresentation, options, vec);
+  if (error==STOFFDocument::STOFF_R_PARSE_ERROR && numPages>0 && options.m_firstPage>numPages) {
+    fprintf(stderr, "ERROR: can not find page %d, the document has %d page(s)!\n", options.m_firstPage, numPages);
+    return 1;
   }
   if (error == STOFFDocument::STOFF_R_FILE_ACCESS_ERROR)
     fprintf(stderr, "ERROR: File Exception!\n");
@@ -173,23 +232,27 @@ int main(int argc, char *argv[])
     return 0;
   }
 
+  if (useRange) {
+    for (unsigned i=0; i<vec.size(); ++i) {
+      if (!output) {
+        writeSVG(std::cout, vec[i]);
+        continue;
+      }
+      std::ofstream out(getPageFileName(output, pageRange[0]+int(i)).c_str());
+      writeSVG(out, vec[i]);
+    }
+    return 0;
+  }
   unsigned page=pageToConvert>0 ? unsigned(pageToConvert-1) : 0;
   if (page>=vec.size()) {
     fprintf(stderr, "ERROR: can not find page %d!\n", int(page));
     return 1;
   }
-  if (!output) {
-    std::cout << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-    std::cout << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
-    std::cout << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
-    std::cout << vec[page].cstr() << std::endl;
-  }
+  if (!output)
+    writeSVG(std::cout, vec[page]);
   else {
     std::ofstream out(output);
-    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-    out << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
-    out << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
-    out << vec[page].cstr() << std::endl;
+    writeSVG(out, vec[page]);
   }
   return 0;
 }
@@ -57,6 +57,7 @@ static int printUsage()
   printf("Usage: " TOOLNAME " [OPTION] INPUT\n");
   printf("\n");
   printf("Options:\n");
+  printf("\t-f                fast mode: only retrieve the main text of a text document\n");
   printf("\t-i                show document metadata instead of the text\n");
   printf("\t-h                show this help message\n");
   printf("\t-o OUTPUT         write ouput to OUTPUT\n");
@@ -67,6 +68,26 @@ static int printUsage()
   return 0;
 }
 
+//! a callback used to store the text retrieved by STOFFDocument::parseText
+class TextCallback final : public STOFFDocument::ParagraphCallback
+{
+public:
+  explicit TextCallback(librevenge::RVNGString &document)
+    : STOFFDocument::ParagraphCallback()
+    , m_document(document)
+  {
+  }
+  void insertParagraph(librevenge::RVNGString const &text) final
+  {
+    m_document.append(text);
+    m_document.append("\n");
+  }
+private:
+  TextCallback(TextCallback const &) = delete;
+  TextCallback &operator=(TextCallback const &) = delete;
+  librevenge::RVNGString &m_document;
+};
+
 static int printVersion()
 {
   printf("%s %s\n", TOOLNAME, VERSION);
@@ -81,11 +102,15 @@ int main(int argc, char *argv[])
   char const *output = nullptr;
   char const *password=nullptr;
   bool isInfo = false;
+  bool fastMode = false;
   bool printHelp=false;
   int ch;
 
-  while ((ch = getopt(argc, argv, "hio:p:v")) != -1) {
+  while ((ch = getopt(argc, argv, "fhio:p:v")) != -1) {
     switch (ch) {
+    case 'f':
+      fastMode=true;
+      break;
     case 'i':
       isInfo=true;
       break;
@@ -165,6 +190,10 @@ int main(int argc, char *argv[])
       }
       useStringVector=true;
     }
+    else if (fastMode && !isInfo && kind == STOFFDocument::STOFF_K_TEXT) {
+      TextCallback callback(document);
+      error=STOFFDocument::parseText(&input, callback, password);
+    }
     else {
       librevenge::RVNGTextTextGenerator documentGenerator(document, isInfo);
       error=STOFFDocument::parse(&input, &documentGenerator, password);
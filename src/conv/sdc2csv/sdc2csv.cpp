@@ -33,15 +33,18 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <cstdlib>
 #include <cstring>
-#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
+#include <librevenge-generators/RVNGDummySpreadsheetGenerator.h>
 #include <librevenge-stream/librevenge-stream.h>
 
 #include <libstaroffice/libstaroffice.hxx>
@@ -64,6 +67,7 @@ static int printUsage()
   printf("\n");
   printf("Options:\n");
   printf("\t-h           show this help message\n");
+  printf("\t-a           convert all the sheets, the sheet NUM is written in OUTPUT-NUM.csv\n");
   printf("\t-d C         set decimal separator: default `.'\n");
   printf("\t-f C         set field separator: default `,'\n");
   printf("\t-t C         set text separator: default `\"'\n");
@@ -91,39 +95,579 @@ static int printVersion()
   return 0;
 }
 
+//! returns the name of the file used to store a sheet: OUTPUT-NUM.csv
+static std::string getSheetFileName(char const *output, int sheet)
+{
+  std::string name(output);
+  auto dotPos=name.rfind('.');
+  auto slashPos=name.rfind('/');
+  if (dotPos!=std::string::npos && (slashPos==std::string::npos || dotPos>slashPos))
+    name=name.substr(0, dotPos);
+  std::stringstream s;
+  s << name << "-" << sheet << ".csv";
+  return s.str();
+}
+
+/** a spreadsheet interface which writes the sheets in CSV while they are parsed
+
+    The output has the same format as librevenge::RVNGCSVSpreadsheetGenerator:
+    a first line Col1,...,ColN, then one line by row where each field is
+    quoted and where each row is completed to have N fields.
+
+    As N is only known at the end of the sheet, each row is formatted when
+    closeSheetRow is called and is stored in a temporary file with its
+    number of fields. When the sheet is closed, the rows are copied in the
+    output file with their missing fields, so only the current row is kept
+    in memory. */
+class CSVStreamGenerator final : public librevenge::RVNGDummySpreadsheetGenerator
+{
+public:
+  //! the CSV options
+  struct Options {
+    //! constructor
+    Options()
+      : m_decimalSeparator('.')
+      , m_fieldSeparator(',')
+      , m_textSeparator('"')
+      , m_dateFormat("%m/%d/%y")
+      , m_timeFormat("%H:%M:%S")
+      , m_generateFormula(false)
+    {
+    }
+    //! the decimal separator
+    char m_decimalSeparator;
+    //! the field separator
+    char m_fieldSeparator;
+    //! the text separator
+    char m_textSeparator;
+    //! the date format
+    std::string m_dateFormat;
+    //! the time format
+    std::string m_timeFormat;
+    //! a flag to know if we output the formula
+    bool m_generateFormula;
+  };
+  /** constructor
+
+      \param options the CSV options
+      \param sheet the sheet to write (0: means first sheet) or -1 to write all sheets or -2 to write nothing
+      \param output the output file: if sheet==-1, the sheet NUM is written in OUTPUT-NUM.csv; if null, the sheet is written in the standard output */
+  CSVStreamGenerator(Options const &options, int sheet, char const *output)
+    : librevenge::RVNGDummySpreadsheetGenerator()
+    , m_options(options)
+    , m_sheetToConvert(sheet)
+    , m_output(output)
+    , m_file(nullptr)
+    , m_fileBuffer()
+    , m_writeError(false)
+    , m_spool(nullptr)
+    , m_numColumns(0)
+    , m_numSheets(0)
+    , m_row(0)
+    , m_rowRepeated(1)
+    , m_numEmptyRows(0)
+    , m_rowBuffer()
+    , m_numFields(0)
+    , m_column(0)
+    , m_cellOpened(false)
+    , m_cellColumn(0)
+    , m_cellRepeated(1)
+    , m_cellValue()
+    , m_cellText()
+    , m_ignoreDepth(0)
+  {
+  }
+  //! destructor
+  ~CSVStreamGenerator() final
+  {
+    closeFile();
+    if (m_spool)
+      fclose(m_spool);
+  }
+  //! returns the number of sheets
+  int getNumSheets() const
+  {
+    return m_numSheets;
+  }
+  //! returns true if an output file can not be opened or written
+  bool hasWriteError() const
+  {
+    return m_writeError;
+  }
+
+  void openSheet(const librevenge::RVNGPropertyList &) final;
+  void closeSheet() final;
+  void openSheetRow(const librevenge::RVNGPropertyList &propList) final;
+  void closeSheetRow() final;
+  void openSheetCell(const librevenge::RVNGPropertyList &propList) final;
+  void closeSheetCell() final;
+
+  void insertTab() final
+  {
+    if (m_cellOpened && !m_ignoreDepth) m_cellText += '\t';
+  }
+  void insertSpace() final
+  {
+    if (m_cellOpened && !m_ignoreDepth) m_cellText += ' ';
+  }
+  void insertText(const librevenge::RVNGString &text) final
+  {
+    if (m_cellOpened && !m_ignoreDepth) m_cellText += text.cstr();
+  }
+  // as in RVNGCSVSpreadsheetGenerator, the paragraphs and the line breaks of a cell are merged
+
+  // the text of the comments, the text boxes, the frames and the charts is ignored
+  void openComment(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_ignoreDepth;
+  }
+  void closeComment() final
+  {
+    --m_ignoreDepth;
+  }
+  void openTextBox(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_ignoreDepth;
+  }
+  void closeTextBox() final
+  {
+    --m_ignoreDepth;
+  }
+  void openFrame(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_ignoreDepth;
+  }
+  void closeFrame() final
+  {
+    --m_ignoreDepth;
+  }
+  void openChart(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_ignoreDepth;
+  }
+  void closeChart() final
+  {
+    --m_ignoreDepth;
+  }
+
+protected:
+  //! returns true if the current sheet must be written
+  bool isSheetSelected() const
+  {
+    return m_file!=nullptr;
+  }
+  //! closes the current output file
+  void closeFile();
+  //! writes a string in the current output file
+  void write(std::string const &str, int numRepeated=1);
+  //! stores a row in the spool file: its number of fields, its number of repetitions and its content
+  void spoolRow(int numFields, int numRepeated, std::string const &row);
+  //! copies the rows of the spool file in the current output file
+  void writeSpooledRows();
+  //! appends a quoted field in the row buffer at a given column, the previous missing fields are created empty
+  void appendField(int column, std::string const &field);
+  //! formats a number
+  std::string formatNumber(double value) const;
+  //! formats a date and/or a time
+  std::string formatDateTime(librevenge::RVNGPropertyList const &propList, bool hasDate, bool hasTime) const;
+  //! formats a formula
+  static std::string formatFormula(librevenge::RVNGPropertyListVector const &formula);
+  //! returns the name of a cell: [$]COL[$]ROW
+  static std::string getCellName(librevenge::RVNGPropertyList const &propList, char const *prefix);
+
+  //! the CSV options
+  Options m_options;
+  //! the sheet to convert
+  int m_sheetToConvert;
+  //! the output file name
+  char const *m_output;
+  //! the current output file
+  FILE *m_file;
+  //! the output file buffer
+  std::string m_fileBuffer;
+  //! a flag to know if an output file can not be written
+  bool m_writeError;
+  //! the file used to store the rows of the current sheet
+  FILE *m_spool;
+  //! the number of columns of the current sheet
+  int m_numColumns;
+  //! the number of sheets
+  int m_numSheets;
+  //! the next row
+  int m_row;
+  //! the number of times the current row is repeated
+  int m_rowRepeated;
+  //! the number of empty rows which are not yet written
+  int m_numEmptyRows;
+  //! the current row
+  std::string m_rowBuffer;
+  //! the number of fields stored in the current row
+  int m_numFields;
+  //! the next column
+  int m_column;
+  //! a flag to know if a cell is opened
+  bool m_cellOpened;
+  //! the current cell column
+  int m_cellColumn;
+  //! the number of times the current cell is repeated
+  int m_cellRepeated;
+  //! the current cell formatted value or formula
+  std::string m_cellValue;
+  //! the current cell text
+  std::string m_cellText;
+  //! the depth of the zones whose text is ignored
+  int m_ignoreDepth;
+private:
+  CSVStreamGenerator(CSVStreamGenerator const &) = delete;
+  CSVStreamGenerator &operator=(CSVStreamGenerator const &) = delete;
+};
+
+void CSVStreamGenerator::closeFile()
+{
+  if (!m_file)
+    return;
+  if (m_file==stdout) {
+    if (fflush(m_file)!=0)
+      m_writeError=true;
+  }
+  else if (ferror(m_file) || fclose(m_file)!=0)
+    m_writeError=true;
+  m_file=nullptr;
+}
+
+void CSVStreamGenerator::write(std::string const &str, int numRepeated)
+{
+  if (!m_file) return;
+  for (int i=0; i<numRepeated; ++i) {
+    if (fwrite(str.c_str(), 1, str.size(), m_file)!=str.size())
+      m_writeError=true;
+  }
+}
+
+void CSVStreamGenerator::openSheet(const librevenge::RVNGPropertyList &)
+{
+  int sheet=m_numSheets++;
+  closeFile();
+  m_row=m_numEmptyRows=m_numColumns=0;
+  m_ignoreDepth=0;
+  if (m_sheetToConvert!=-1 && m_sheetToConvert!=sheet)
+    return;
+  if (m_spool)
+    rewind(m_spool);
+  else if (!(m_spool=tmpfile())) {
+    fprintf(stderr, "ERROR: can not create a temporary file!\n");
+    m_writeError=true;
+    return;
+  }
+  if (!m_output)
+    m_file=stdout;
+  else {
+    std::string name=m_sheetToConvert==-1 ? getSheetFileName(m_output, sheet+1) : std::string(m_output);
+    m_file=fopen(name.c_str(), "wb");
+    if (!m_file) {
+      fprintf(stderr, "ERROR: can not open file %s!\n", name.c_str());
+      m_writeError=true;
+      return;
+    }
+    m_fileBuffer.resize(1<<16);
+    setvbuf(m_file, &m_fileBuffer[0], _IOFBF, m_fileBuffer.size());
+  }
+}
+
+void CSVStreamGenerator::closeSheet()
+{
+  // the empty rows at the end of the sheet are not written
+  if (isSheetSelected())
+    writeSpooledRows();
+  closeFile();
+}
+
+void CSVStreamGenerator::spoolRow(int numFields, int numRepeated, std::string const &row)
+{
+  int const header[]= {numFields, numRepeated, int(row.size())};
+  if (fwrite(header, sizeof(header), 1, m_spool)!=1 ||
+      (!row.empty() && fwrite(row.c_str(), 1, row.size(), m_spool)!=row.size()))
+    m_writeError=true;
+  if (numFields>m_numColumns)
+    m_numColumns=numFields;
+}
+
+void CSVStreamGenerator::writeSpooledRows()
+{
+  long const end=ftell(m_spool);
+  if (end<0 || fflush(m_spool)!=0) {
+    m_writeError=true;
+    return;
+  }
+  rewind(m_spool);
+  std::string row;
+  for (int c=0; c<m_numColumns; ++c) {
+    if (c) row+=m_options.m_fieldSeparator;
+    std::stringstream s;
+    s << "Col" << c+1;
+    row+=s.str();
+  }
+  row+='\n';
+  write(row);
+  std::string emptyField;
+  emptyField+=m_options.m_fieldSeparator;
+  emptyField+=m_options.m_textSeparator;
+  emptyField+=m_options.m_textSeparator;
+  while (ftell(m_spool)<end) {
+    int header[3];
+    if (fread(header, sizeof(header), 1, m_spool)!=1 || header[2]<0) {
+      m_writeError=true;
+      break;
+    }
+    row.resize(size_t(header[2]));
+    if (header[2] && fread(&row[0], 1, row.size(), m_spool)!=row.size()) {
+      m_writeError=true;
+      break;
+    }
+    int numFields=header[0];
+    if (!numFields && m_numColumns) {
+      row=emptyField.substr(1);
+      numFields=1;
+    }
+    for (int c=numFields; c<m_numColumns; ++c)
+      row+=emptyField;
+    row+='\n';
+    write(row, header[1]);
+  }
+  // RVNGCSVSpreadsheetGenerator's sheet is followed by a new line
+  write("\n");
+}
+
+void CSVStreamGenerator::openSheetRow(const librevenge::RVNGPropertyList &propList)
+{
+  m_rowRepeated=1;
+  if (propList["table:number-rows-repeated"] && propList["table:number-rows-repeated"]->getInt()>1)
+    m_rowRepeated=propList["table:number-rows-repeated"]->getInt();
+  m_rowBuffer.clear();
+  m_numFields=m_column=0;
+}
+
+void CSVStreamGenerator::closeSheetRow()
+{
+  if (isSheetSelected()) {
+    if (!m_numFields)
+      m_numEmptyRows+=m_rowRepeated;
+    else {
+      if (m_numEmptyRows)
+        spoolRow(0, m_numEmptyRows, "");
+      m_numEmptyRows=0;
+      spoolRow(m_numFields, m_rowRepeated, m_rowBuffer);
+    }
+  }
+  m_row+=m_rowRepeated;
+}
+
+void CSVStreamGenerator::appendField(int column, std::string const &field)
+{
+  if (column<m_numFields)
+    return;
+  for (; m_numFields<column; ++m_numFields) {
+    if (m_numFields) m_rowBuffer+=m_options.m_fieldSeparator;
+    m_rowBuffer+=m_options.m_textSeparator;
+    m_rowBuffer+=m_options.m_textSeparator;
+  }
+  if (m_numFields) m_rowBuffer+=m_options.m_fieldSeparator;
+  m_numFields=column+1;
+  m_rowBuffer+=m_options.m_textSeparator;
+  for (auto c : field) {
+    if (c==m_options.m_textSeparator)
+      m_rowBuffer+=c;
+    m_rowBuffer+=c;
+  }
+  m_rowBuffer+=m_options.m_textSeparator;
+}
+
+void CSVStreamGenerator::openSheetCell(const librevenge::RVNGPropertyList &propList)
+{
+  m_cellOpened=true;
+  m_cellValue.clear();
+  m_cellText.clear();
+  m_cellColumn=propList["librevenge:column"] ? propList["librevenge:column"]->getInt() : m_column;
+  m_cellRepeated=1;
+  if (propList["table:number-columns-repeated"] && propList["table:number-columns-repeated"]->getInt()>1)
+    m_cellRepeated=propList["table:number-columns-repeated"]->getInt();
+  if (propList["librevenge:row"] && propList["librevenge:row"]->getInt()>m_row) {
+    // the rows before this one are empty
+    m_numEmptyRows+=propList["librevenge:row"]->getInt()-m_row;
+    m_row=propList["librevenge:row"]->getInt();
+  }
+  if (!isSheetSelected())
+    return;
+
+  if (m_options.m_generateFormula && propList.child("librevenge:formula")) {
+    m_cellValue=formatFormula(*propList.child("librevenge:formula"));
+    if (!m_cellValue.empty())
+      return;
+  }
+  if (!propList["librevenge:value-type"])
+    return;
+  std::string type(propList["librevenge:value-type"]->getStr().cstr());
+  if (type=="date")
+    m_cellValue=formatDateTime(propList, propList["librevenge:year"]!=nullptr, propList["librevenge:hours"]!=nullptr);
+  else if (type=="time")
+    m_cellValue=formatDateTime(propList, false, propList["librevenge:hours"]!=nullptr);
+  else if (!propList["librevenge:value"] || type=="string" || type=="text")
+    return;
+  else if (type=="boolean")
+    m_cellValue=propList["librevenge:value"]->getDouble()>0 ? "true" : "false";
+  else if (type=="percent" || type=="percentage")
+    m_cellValue=formatNumber(100*propList["librevenge:value"]->getDouble())+"%";
+  else
+    m_cellValue=formatNumber(propList["librevenge:value"]->getDouble());
+}
+
+void CSVStreamGenerator::closeSheetCell()
+{
+  if (!m_cellOpened)
+    return;
+  m_cellOpened=false;
+  std::string const &field=m_cellValue.empty() ? m_cellText : m_cellValue;
+  if (isSheetSelected() && !field.empty()) {
+    for (int c=0; c<m_cellRepeated; ++c)
+      appendField(m_cellColumn+c, field);
+  }
+  m_column=m_cellColumn+m_cellRepeated;
+}
+
+std::string CSVStreamGenerator::formatNumber(double value) const
+{
+  char buffer[50];
+  snprintf(buffer, sizeof(buffer), "%.15g", value);
+  std::string res(buffer);
+  if (m_options.m_decimalSeparator!='.') {
+    auto pos=res.find('.');
+    if (pos!=std::string::npos)
+      res[pos]=m_options.m_decimalSeparator;
+  }
+  return res;
+}
+
+std::string CSVStreamGenerator::formatDateTime(librevenge::RVNGPropertyList const &propList, bool hasDate, bool hasTime) const
+{
+  if (!hasDate && !hasTime)
+    return "";
+  struct tm time;
+  std::memset(&time, 0, sizeof(time));
+  if (hasDate) {
+    time.tm_year=propList["librevenge:year"]->getInt()-1900;
+    time.tm_mon=propList["librevenge:month"] ? propList["librevenge:month"]->getInt()-1 : 0;
+    time.tm_mday=propList["librevenge:day"] ? propList["librevenge:day"]->getInt() : 1;
+    // let mktime compute the day of the week and the day of the year
+    time.tm_hour=12;
+    time.tm_isdst=-1;
+    mktime(&time);
+  }
+  if (hasTime) {
+    time.tm_hour=propList["librevenge:hours"]->getInt();
+    time.tm_min=propList["librevenge:minutes"] ? propList["librevenge:minutes"]->getInt() : 0;
+    time.tm_sec=propList["librevenge:seconds"] ? propList["librevenge:seconds"]->getInt() : 0;
+  }
+  std::string format;
+  if (hasDate)
+    format=m_options.m_dateFormat;
+  if (hasTime)
+    format+=(hasDate ? " " : "")+m_options.m_timeFormat;
+  char buffer[256];
+  if (format.empty() || strftime(buffer, sizeof(buffer), format.c_str(), &time)==0)
+    return "";
+  return buffer;
+}
+
+std::string CSVStreamGenerator::getCellName(librevenge::RVNGPropertyList const &propList, char const *prefix)
+{
+  std::string const pre(prefix);
+  std::stringstream s;
+  auto const *column=propList[(pre+"column").c_str()];
+  auto const *row=propList[(pre+"row").c_str()];
+  if (!column || !row)
+    return "";
+  auto const *absolute=propList[(pre+"column-absolute").c_str()];
+  if (absolute && absolute->getInt())
+    s << "$";
+  std::string name;
+  for (int col=column->getInt(); col>=0; col=col/26-1)
+    name.insert(name.begin(), char('A'+col%26));
+  s << name;
+  absolute=propList[(pre+"row-absolute").c_str()];
+  if (absolute && absolute->getInt())
+    s << "$";
+  s << row->getInt()+1;
+  return s.str();
+}
+
+std::string CSVStreamGenerator::formatFormula(librevenge::RVNGPropertyListVector const &formula)
+{
+  std::stringstream s;
+  s << "=";
+  for (unsigned long i=0; i<formula.count(); ++i) {
+    auto const &instr=formula[i];
+    if (!instr["librevenge:type"])
+      return "";
+    std::string type(instr["librevenge:type"]->getStr().cstr());
+    if (type=="librevenge-operator" && instr["librevenge:operator"])
+      s << instr["librevenge:operator"]->getStr().cstr();
+    else if (type=="librevenge-function" && instr["librevenge:function"])
+      s << instr["librevenge:function"]->getStr().cstr();
+    else if (type=="librevenge-text" && instr["librevenge:text"])
+      s << "\"" << instr["librevenge:text"]->getStr().cstr() << "\"";
+    else if (type=="librevenge-number" && instr["librevenge:number"])
+      s << instr["librevenge:number"]->getStr().cstr();
+    else if (type=="librevenge-cell") {
+      if (instr["librevenge:sheet"])
+        s << instr["librevenge:sheet"]->getStr().cstr() << ".";
+      s << getCellName(instr, "librevenge:");
+    }
+    else if (type=="librevenge-cells") {
+      if (instr["librevenge:sheet-name"])
+        s << instr["librevenge:sheet-name"]->getStr().cstr() << ".";
+      s << getCellName(instr, "librevenge:start-") << ":" << getCellName(instr, "librevenge:end-");
+    }
+    else
+      return "";
+  }
+  return s.str();
+}
+
 int main(int argc, char *argv[])
 {
   bool printHelp=false;
   bool printNumberOfSheet=false;
-  bool generateFormula=false;
+  bool convertAllSheets=false;
   int sheetToConvert=0;
   char const *output = nullptr;
   int ch;
-  char decSeparator='.', fieldSeparator=',', textSeparator='"';
-  std::string dateFormat("%m/%d/%y"), timeFormat("%H:%M:%S");
+  CSVStreamGenerator::Options options;
 
-  while ((ch = getopt(argc, argv, "hvo:d:f:t:D:FNn:T:")) != -1) {
+  while ((ch = getopt(argc, argv, "ahvo:d:f:t:D:FNn:T:")) != -1) {
     switch (ch) {
+    case 'a':
+      convertAllSheets=true;
+      break;
     case 'D':
-      dateFormat=optarg;
+      options.m_dateFormat=optarg;
       break;
     case 'F':
-      generateFormula=true;
+      options.m_generateFormula=true;
       break;
     case 'N':
       printNumberOfSheet=true;
       break;
     case 'T':
-      timeFormat=optarg;
+      options.m_timeFormat=optarg;
       break;
     case 'd':
-      decSeparator=optarg[0];
+      options.m_decimalSeparator=optarg[0];
       break;
     case 'f':
-      fieldSeparator=optarg[0];
+      options.m_fieldSeparator=optarg[0];
       break;
     case 't':
-      textSeparator=optarg[0];
+      options.m_textSeparator=optarg[0];
       break;
     case 'n':
       sheetToConvert=std::atoi(optarg);
@@ -140,7 +684,7 @@ int main(int argc, char *argv[])
       break;
     }
   }
-  if (argc != 1+optind || printHelp) {
+  if (argc != 1+optind || printHelp || (convertAllSheets && !output)) {
     printUsage();
     return -1;
   }
@@ -165,12 +709,9 @@ int main(int argc, char *argv[])
     return 1;
   }
   auto error=STOFFDocument::STOFF_R_OK;
-  librevenge::RVNGStringVector vec;
-
+  int sheet=printNumberOfSheet ? -2 : convertAllSheets ? -1 : sheetToConvert>0 ? sheetToConvert-1 : 0;
+  CSVStreamGenerator listenerImpl(options, sheet, output);
   try {
-    librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
-    listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
-    listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
     error= STOFFDocument::parse(&input, &listenerImpl);
   }
   catch (STOFFDocument::Result const &err) {
@@ -192,20 +733,17 @@ int main(int argc, char *argv[])
     return 1;
 
   if (printNumberOfSheet) {
-    std::cout << vec.size() << "\n";
+    std::cout << listenerImpl.getNumSheets() << "\n";
     return 0;
   }
 
-  unsigned page=sheetToConvert>0 ? unsigned(sheetToConvert-1) : 0;
-  if (page>=vec.size()) {
-    fprintf(stderr, "ERROR: can not find page %d!\n", int(page));
+  if (sheet>=listenerImpl.getNumSheets()) {
+    fprintf(stderr, "ERROR: can not find page %d!\n", sheet);
     return 1;
   }
-  if (!output)
-    std::cout << vec[page].cstr() << std::endl;
-  else {
-    std::ofstream out(output);
-    out << vec[page].cstr() << std::endl;
+  if (listenerImpl.hasWriteError()) {
+    fprintf(stderr, "ERROR: can not write the output!\n");
+    return 1;
   }
   return 0;
 }
@@ -0,0 +1,603 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#include <stdio.h>
+#include <dirent.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <librevenge/librevenge.h>
+#include <librevenge-generators/librevenge-generators.h>
+#include <librevenge-stream/librevenge-stream.h>
+
+#include <libstaroffice/libstaroffice.hxx>
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifndef VERSION
+#define VERSION "UNKNOWN VERSION"
+#endif
+
+#define TOOLNAME "sdconvert"
+
+//! the default maximal duration of a conversion in seconds
+#define DEFAULT_TIMEOUT 300
+//! the address space given to a worker in addition to the memory budget (in Mb)
+#define ADDRESS_SPACE_MARGIN 256
+
+static int printUsage()
+{
+  printf("`" TOOLNAME "' converts a batch of StarOffice documents.\n");
+  printf("\n");
+  printf("Usage: " TOOLNAME " [OPTION] -m MANIFEST\n");
+  printf("       " TOOLNAME " [OPTION] -d DIRECTORY\n");
+  printf("\n");
+  printf("The output format is given by the extension of the output file:\n");
+  printf(".txt (all documents), .csv (spreadsheets), .html (text documents)\n");
+  printf("or .svg (graphics and presentations, one file OUTPUT-NUM.svg by page).\n");
+  printf("\n");
+  printf("Options:\n");
+  printf("\t-d DIRECTORY       convert all the files of the directory tree DIRECTORY\n");
+  printf("\t-f FORMAT          choose the output format used with -d: txt, csv, html or svg\n");
+  printf("\t                   (default: txt)\n");
+  printf("\t-h                 show this help message\n");
+  printf("\t-j NUM             use NUM worker processes (default: 1)\n");
+  printf("\t-m MANIFEST        convert the files listed in MANIFEST, each line contains\n");
+  printf("\t                   an input file and an output file separated by a tabulation\n");
+  printf("\t-M SIZE            stop the conversion of a file when it needs more than SIZE Mb;\n");
+  printf("\t                   the worker's address space is also limited to SIZE+%d Mb\n", ADDRESS_SPACE_MARGIN);
+  printf("\t-O DIRECTORY       write the files converted with -d in DIRECTORY\n");
+  printf("\t                   (default: next to the input files)\n");
+  printf("\t-s SUMMARY         write the JSON summary to SUMMARY (default: standard output)\n");
+  printf("\t-t SECONDS         stop the conversion of a file after SECONDS seconds\n");
+  printf("\t                   (default: %d, 0: no limit)\n", DEFAULT_TIMEOUT);
+  printf("\t-v                 show version information\n");
+  printf("\n");
+  printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
+  return -1;
+}
+
+static int printVersion()
+{
+  printf("%s %s\n", TOOLNAME, VERSION);
+  return 0;
+}
+
+/** the status returned by a worker when the conversion fails before or
+    after the parsing, the other status are STOFFDocument::Result */
+enum ConvertStatus {
+  C_UNSUPPORTED_FILE=100 /**< the input is not a StarOffice document*/,
+  C_UNSUPPORTED_FORMAT /**< the output format can not be used for this kind of document*/,
+  C_EMPTY_DOCUMENT /**< the parser has not created any data*/,
+  C_WRITE_ERROR /**< the output can not be written*/
+};
+
+//! a file to convert and the result of its conversion
+struct Job {
+  //! constructor
+  Job(std::string const &input, std::string const &output)
+    : m_input(input)
+    , m_output(output)
+    , m_pid(-1)
+    , m_start()
+    , m_status(-1)
+    , m_signal(0)
+    , m_time(0)
+  {
+  }
+  //! the input file
+  std::string m_input;
+  //! the output file
+  std::string m_output;
+  //! the worker process
+  pid_t m_pid;
+  //! the time when the worker was created
+  std::chrono::steady_clock::time_point m_start;
+  //! the worker exit status or -1 if it has been killed by a signal
+  int m_status;
+  //! the signal which has killed the worker
+  int m_signal;
+  //! the conversion time in seconds
+  double m_time;
+};
+
+//! returns the extension of a file name (without the dot)
+static std::string getExtension(std::string const &name)
+{
+  auto dotPos=name.rfind('.');
+  auto slashPos=name.rfind('/');
+  if (dotPos==std::string::npos || (slashPos!=std::string::npos && dotPos<slashPos))
+    return "";
+  return name.substr(dotPos+1);
+}
+
+//! returns the name of the file used to store a page: OUTPUT-NUM.svg
+static std::string getPageFileName(std::string const &output, int page)
+{
+  std::string name(output);
+  if (!getExtension(name).empty())
+    name=name.substr(0, name.rfind('.'));
+  std::stringstream s;
+  s << name << "-" << page << ".svg";
+  return s.str();
+}
+
+static void writeSVG(std::ostream &out, librevenge::RVNGString const &page)
+{
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+  out << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
+  out << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
+  out << page.cstr() << std::endl;
+}
+
+//! writes the data in a file, returns false if the file can not be written
+static bool writeFile(std::string const &output, librevenge::RVNGString const &document, librevenge::RVNGStringVector const &pages, bool useStringVector)
+{
+  FILE *out=fopen(output.c_str(), "wb");
+  if (!out)
+    return false;
+  if (!useStringVector)
+    fprintf(out, "%s", document.cstr());
+  else {
+    for (unsigned i=0; i < pages.size(); ++i)
+      fprintf(out, "%s\n", pages[i].cstr());
+  }
+  bool ok=ferror(out)==0;
+  return fclose(out)==0 && ok;
+}
+
+//! converts a file, returns a STOFFDocument::Result or a ConvertStatus
+static int convert(Job const &job, STOFFDocument::ParseOptions const &options)
+{
+  librevenge::RVNGFileStream input(job.m_input.c_str());
+
+  STOFFDocument::Kind kind;
+  auto confidence = STOFFDocument::STOFF_C_NONE;
+  try {
+    confidence=STOFFDocument::isFileFormatSupported(&input, kind);
+  }
+  catch (...) {
+    confidence = STOFFDocument::STOFF_C_NONE;
+  }
+  if (confidence != STOFFDocument::STOFF_C_EXCELLENT && confidence != STOFFDocument::STOFF_C_SUPPORTED_ENCRYPTION)
+    return C_UNSUPPORTED_FILE;
+
+  bool isGraphic=kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC;
+  bool isSpreadsheet=kind == STOFFDocument::STOFF_K_SPREADSHEET || kind == STOFFDocument::STOFF_K_DATABASE;
+  bool isPresentation=kind == STOFFDocument::STOFF_K_PRESENTATION;
+  std::string const format=getExtension(job.m_output);
+  librevenge::RVNGString document;
+  librevenge::RVNGStringVector pages;
+  bool useStringVector=true;
+  auto error = STOFFDocument::STOFF_R_OK;
+  try {
+    if (format=="csv") {
+      if (!isSpreadsheet)
+        return C_UNSUPPORTED_FORMAT;
+      librevenge::RVNGCSVSpreadsheetGenerator documentGenerator(pages);
+      error=STOFFDocument::parse(&input, &documentGenerator, options);
+      // only the first sheet is stored, as in sdc2csv
+      if (!pages.empty())
+        document=pages[0];
+      useStringVector=false;
+    }
+    else if (format=="html") {
+      if (isGraphic || isSpreadsheet || isPresentation)
+        return C_UNSUPPORTED_FORMAT;
+      librevenge::RVNGHTMLTextGenerator documentGenerator(document);
+      error=STOFFDocument::parse(&input, &documentGenerator, options);
+      useStringVector=false;
+    }
+    else if (format=="svg") {
+      if (isPresentation) {
+        librevenge::RVNGSVGPresentationGenerator documentGenerator(pages);
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+      }
+      else if (isGraphic) {
+        librevenge::RVNGSVGDrawingGenerator documentGenerator(pages, "");
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+      }
+      else
+        return C_UNSUPPORTED_FORMAT;
+    }
+    else if (format=="txt") {
+      if (isGraphic) {
+        librevenge::RVNGTextDrawingGenerator documentGenerator(pages);
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+      }
+      else if (isSpreadsheet) {
+        librevenge::RVNGTextSpreadsheetGenerator documentGenerator(pages);
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+      }
+      else if (isPresentation) {
+        librevenge::RVNGTextPresentationGenerator documentGenerator(pages);
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+      }
+      else {
+        librevenge::RVNGTextTextGenerator documentGenerator(document);
+        error=STOFFDocument::parse(&input, &documentGenerator, options);
+        useStringVector=false;
+      }
+    }
+    else
+      return C_UNSUPPORTED_FORMAT;
+  }
+  catch (STOFFDocument::Result const &err) {
+    error=err;
+  }
+  catch (...) {
+    error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  }
+  if (error != STOFFDocument::STOFF_R_OK)
+    return error;
+  if (useStringVector ? pages.empty() : document.empty())
+    return C_EMPTY_DOCUMENT;
+
+  if (format!="svg")
+    return writeFile(job.m_output, document, pages, useStringVector) ? 0 : C_WRITE_ERROR;
+  for (unsigned i=0; i<pages.size(); ++i) {
+    std::ofstream out(pages.size()==1 ? job.m_output : getPageFileName(job.m_output, int(i+1)));
+    if (!out)
+      return C_WRITE_ERROR;
+    writeSVG(out, pages[i]);
+    if (!out)
+      return C_WRITE_ERROR;
+  }
+  return 0;
+}
+
+//! reads the manifest: one "INPUT\tOUTPUT" by line, empty lines and lines beginning with # are ignored
+static bool readManifest(char const *fileName, std::vector<Job> &jobs)
+{
+  std::ifstream file(fileName);
+  if (!file)
+    return false;
+  std::string line;
+  int lineNumber=0;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (!line.empty() && line[line.size()-1]=='\r')
+      line.resize(line.size()-1);
+    if (line.empty() || line[0]=='#')
+      continue;
+    auto tabPos=line.find('\t');
+    if (tabPos==std::string::npos || tabPos==0 || tabPos+1==line.size()) {
+      fprintf(stderr, "ERROR: %s:%d: expected INPUT<tab>OUTPUT\n", fileName, lineNumber);
+      return false;
+    }
+    jobs.push_back(Job(line.substr(0, tabPos), line.substr(tabPos+1)));
+  }
+  return true;
+}
+
+//! creates a directory and its parents if they do not exist
+static bool createDirectory(std::string const &dir)
+{
+  if (dir.empty())
+    return true;
+  struct stat status;
+  if (stat(dir.c_str(), &status)==0)
+    return S_ISDIR(status.st_mode);
+  auto slashPos=dir.rfind('/');
+  if (slashPos!=std::string::npos && slashPos>0 && !createDirectory(dir.substr(0, slashPos)))
+    return false;
+  return mkdir(dir.c_str(), 0777)==0;
+}
+
+/** adds the regular files of the directory tree dir to the jobs, the output of
+    a file is stored in outputDir (or next to the file if outputDir is empty) */
+static bool readDirectory(std::string const &dir, std::string const &outputDir, std::string const &format, std::vector<Job> &jobs)
+{
+  DIR *directory=opendir(dir.c_str());
+  if (!directory) {
+    fprintf(stderr, "ERROR: can not open the directory %s!\n", dir.c_str());
+    return false;
+  }
+  std::vector<std::string> names;
+  while (auto entry=readdir(directory)) {
+    std::string name(entry->d_name);
+    if (name!="." && name!="..")
+      names.push_back(name);
+  }
+  closedir(directory);
+  // sort the names to have a reproducible summary
+  std::sort(names.begin(), names.end());
+
+  bool ok=true;
+  for (auto const &name : names) {
+    std::string path=dir+"/"+name;
+    struct stat status;
+    if (stat(path.c_str(), &status)!=0)
+      continue;
+    std::string output=outputDir.empty() ? path : outputDir+"/"+name;
+    if (S_ISDIR(status.st_mode)) {
+      if (!readDirectory(path, outputDir.empty() ? outputDir : output, format, jobs))
+        ok=false;
+    }
+    else if (S_ISREG(status.st_mode) && getExtension(name)!=format) {
+      if (!outputDir.empty() && !createDirectory(outputDir)) {
+        fprintf(stderr, "ERROR: can not create the directory %s!\n", outputDir.c_str());
+        return false;
+      }
+      jobs.push_back(Job(path, output+"."+format));
+    }
+  }
+  return ok;
+}
+
+//! returns the name of a worker status
+static char const *getStatusName(Job const &job)
+{
+  if (job.m_status<0)
+    return job.m_signal==SIGALRM ? "TIMEOUT" : "CRASH";
+  switch (job.m_status) {
+  case STOFFDocument::STOFF_R_OK:
+    return "OK";
+  case STOFFDocument::STOFF_R_FILE_ACCESS_ERROR:
+    return "FILE_ACCESS_ERROR";
+  case STOFFDocument::STOFF_R_OLE_ERROR:
+    return "OLE_ERROR";
+  case STOFFDocument::STOFF_R_PARSE_ERROR:
+    return "PARSE_ERROR";
+  case STOFFDocument::STOFF_R_PASSWORD_MISSMATCH_ERROR:
+    return "PASSWORD_MISSMATCH_ERROR";
+  case STOFFDocument::STOFF_R_UNKNOWN_ERROR:
+    return "UNKNOWN_ERROR";
+  case STOFFDocument::STOFF_R_CANCELLED:
+    return "CANCELLED";
+  case STOFFDocument::STOFF_R_MEMORY_LIMIT_ERROR:
+    return "MEMORY_LIMIT_ERROR";
+  case C_UNSUPPORTED_FILE:
+    return "UNSUPPORTED_FILE";
+  case C_UNSUPPORTED_FORMAT:
+    return "UNSUPPORTED_FORMAT";
+  case C_EMPTY_DOCUMENT:
+    return "EMPTY_DOCUMENT";
+  case C_WRITE_ERROR:
+    return "WRITE_ERROR";
+  default:
+    break;
+  }
+  return "UNKNOWN_STATUS";
+}
+
+static std::string escapeJSON(std::string const &str)
+{
+  std::string res;
+  for (char c : str) {
+    if (c=='"' || c=='\\')
+      res+='\\';
+    res+=c;
+  }
+  return res;
+}
+
+//! writes the summary in JSON, one line by file
+static bool writeSummary(FILE *file, std::vector<Job> const &jobs, int numFailures)
+{
+  fprintf(file, "{\n\"files\": [\n");
+  for (size_t i=0; i<jobs.size(); ++i) {
+    auto const &job=jobs[i];
+    fprintf(file, "{\"input\": \"%s\", \"output\": \"%s\", \"status\": \"%s\", \"code\": %d, \"signal\": %d, \"time\": %.6f}%s\n",
+            escapeJSON(job.m_input).c_str(), escapeJSON(job.m_output).c_str(), getStatusName(job), job.m_status, job.m_signal, job.m_time,
+            i+1<jobs.size() ? "," : "");
+  }
+  fprintf(file, "],\n\"numFiles\": %d,\n\"numFailures\": %d\n}\n", int(jobs.size()), numFailures);
+  return ferror(file)==0;
+}
+
+//! the new handler of a worker: its address space is exhausted
+static void exitOnMemoryError()
+{
+  _exit(STOFFDocument::STOFF_R_MEMORY_LIMIT_ERROR);
+}
+
+/** creates a worker process which converts a job and exits with its status
+
+    \note the worker also sets an alarm, so that a conversion which does not
+    check the time limit is killed by SIGALRM, and, if a memory budget is
+    given, limits its address space, so that the allocations which are not
+    charged to the budget can not exhaust the memory of the machine */
+static bool startWorker(Job &job, STOFFDocument::ParseOptions const &options)
+{
+  fflush(stdout);
+  fflush(stderr);
+  job.m_start=std::chrono::steady_clock::now();
+  pid_t pid=fork();
+  if (pid<0)
+    return false;
+  if (pid==0) {
+    if (options.m_maxDuration>0)
+      alarm(static_cast<unsigned>(options.m_maxDuration)+5);
+    if (options.m_maxMemory>0) {
+      struct rlimit limit;
+      limit.rlim_cur=limit.rlim_max=rlim_t(options.m_maxMemory)+rlim_t(ADDRESS_SPACE_MARGIN)*1024*1024;
+      if (setrlimit(RLIMIT_AS, &limit)!=0)
+        fprintf(stderr, "WARNING: can not limit the address space of the worker for %s\n", job.m_input.c_str());
+      std::set_new_handler(exitOnMemoryError);
+    }
+    int status=STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+    try {
+      status=convert(job, options);
+    }
+    catch (...) {
+    }
+    _exit(status);
+  }
+  job.m_pid=pid;
+  return true;
+}
+
+/** converts the jobs using at most numWorkers processes, returns the number of failures */
+static int convertJobs(std::vector<Job> &jobs, int numWorkers, STOFFDocument::ParseOptions const &options)
+{
+  std::map<pid_t, size_t> running;
+  size_t next=0;
+  int numFailures=0;
+  while (next<jobs.size() || !running.empty()) {
+    while (next<jobs.size() && int(running.size())<numWorkers) {
+      auto &job=jobs[next];
+      if (!startWorker(job, options)) {
+        fprintf(stderr, "ERROR: can not create a worker for %s!\n", job.m_input.c_str());
+        job.m_status=STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+        ++numFailures;
+      }
+      else
+        running[job.m_pid]=next;
+      ++next;
+    }
+    if (running.empty())
+      continue;
+    int status;
+    pid_t pid=waitpid(-1, &status, 0);
+    if (pid<0)
+      break;
+    auto it=running.find(pid);
+    if (it==running.end())
+      continue;
+    auto &job=jobs[it->second];
+    running.erase(it);
+    job.m_time=std::chrono::duration<double>(std::chrono::steady_clock::now()-job.m_start).count();
+    if (WIFEXITED(status))
+      job.m_status=WEXITSTATUS(status);
+    else if (WIFSIGNALED(status)) {
+      job.m_status=-1;
+      job.m_signal=WTERMSIG(status);
+    }
+    if (job.m_status!=STOFFDocument::STOFF_R_OK) {
+      fprintf(stderr, "%s: %s\n", job.m_input.c_str(), getStatusName(job));
+      ++numFailures;
+    }
+  }
+  return numFailures;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+    return printUsage();
+
+  char const *manifest=nullptr;
+  char const *directory=nullptr;
+  char const *outputDir=nullptr;
+  char const *summary=nullptr;
+  std::string format("txt");
+  int numWorkers=1;
+  STOFFDocument::ParseOptions options;
+  options.m_maxDuration=DEFAULT_TIMEOUT;
+  bool printHelp=false;
+  int ch;
+
+  while ((ch = getopt(argc, argv, "d:f:hj:m:M:O:s:t:v")) != -1) {
+    switch (ch) {
+    case 'd':
+      directory=optarg;
+      break;
+    case 'f':
+      format=optarg;
+      break;
+    case 'j':
+      numWorkers=std::atoi(optarg);
+      break;
+    case 'm':
+      manifest=optarg;
+      break;
+    case 'M':
+      options.m_maxMemory=std::strtoul(optarg, nullptr, 10)*1024*1024;
+      break;
+    case 'O':
+      outputDir=optarg;
+      break;
+    case 's':
+      summary=optarg;
+      break;
+    case 't':
+      options.m_maxDuration=std::atof(optarg);
+      break;
+    case 'v':
+      printVersion();
+      return 0;
+    default:
+    case 'h':
+      printHelp = true;
+      break;
+    }
+  }
+
+  if (printHelp || argc != optind || (manifest==nullptr) == (directory==nullptr) || numWorkers<=0 ||
+      options.m_maxDuration<0 || (format!="txt" && format!="csv" && format!="html" && format!="svg"))
+    return printUsage();
+
+  std::vector<Job> jobs;
+  if (manifest && !readManifest(manifest, jobs)) {
+    fprintf(stderr, "ERROR: can not read the manifest %s!\n", manifest);
+    return 1;
+  }
+  if (directory && !readDirectory(directory, outputDir ? outputDir : "", format, jobs))
+    return 1;
+
+  int numFailures=convertJobs(jobs, numWorkers, options);
+
+  FILE *file=summary ? fopen(summary, "w") : stdout;
+  if (!file) {
+    fprintf(stderr, "ERROR: can not open file %s!\n", summary);
+    return 1;
+  }
+  bool ok=writeSummary(file, jobs, numFailures);
+  if (summary && fclose(file)!=0)
+    ok=false;
+  if (!ok) {
+    fprintf(stderr, "ERROR: can not write the summary!\n");
+    return 1;
+  }
+  return numFailures ? 1 : 0;
+}
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
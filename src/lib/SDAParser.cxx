@@ -58,11 +58,14 @@ struct State {
   State()
     : m_actPage(0)
     , m_numPages(0)
+    , m_numDocumentPages(0)
     , m_mainGraphic()
   {
   }
 
   int m_actPage /** the actual page */, m_numPages /** the number of page of the final document */;
+  //! the number of pages of the document
+  int m_numDocumentPages;
   std::shared_ptr<StarObjectDraw> m_mainGraphic;
 };
 
@@ -75,6 +78,7 @@ SDAParser::SDAParser(STOFFInputStreamPtr &input, STOFFHeader *header)
   : STOFFGraphicParser(input, header)
   , m_password(nullptr)
   , m_oleParser()
+  , m_pageRange()
   , m_state(new SDAParserInternal::State)
 {
 }
@@ -140,6 +144,22 @@ void SDAParser::parse(librevenge::RVNGPresentationInterface *docInterface)
   if (!ok) throw(libstoff::ParseException());
 }
 
+bool SDAParser::countPages(int &numPages)
+{
+  numPages=0;
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  if (!createZones() || !m_state->m_mainGraphic)
+    return false;
+  numPages=m_state->m_numDocumentPages=m_state->m_mainGraphic->getNumPages();
+  ascii().reset();
+  return numPages>0;
+}
+
+int SDAParser::getNumPages() const
+{
+  return m_state->m_numDocumentPages;
+}
+
 bool SDAParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -157,23 +177,34 @@ bool SDAParser::createZones()
     return false;
   }
   m_state->m_mainGraphic.reset(new StarObjectDraw(mainObject, false));
+  m_state->m_mainGraphic->setPageRange(m_pageRange[0], m_pageRange[1]);
   return m_state->m_mainGraphic->parse();
 }
 
 ////////////////////////////////////////////////////////////
 // create the document and send data
 ////////////////////////////////////////////////////////////
-void SDAParser::createDocument(librevenge::RVNGDrawingInterface *documentInterface)
+void SDAParser::updatePageSpans(std::vector<STOFFPageSpan> &pageList)
 {
-  if (!documentInterface) return;
-
-  std::vector<STOFFPageSpan> pageList;
+  m_state->m_numDocumentPages=m_state->m_mainGraphic ? m_state->m_mainGraphic->getNumPages() : 0;
+  if (m_pageRange[0]>0 && m_pageRange[0]>m_state->m_numDocumentPages) {
+    STOFF_DEBUG_MSG(("SDAParser::updatePageSpans: can not find page %d\n", m_pageRange[0]));
+    throw libstoff::ParseException();
+  }
   if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages)) {
     STOFFPageSpan ps(getPageSpan());
     ps.m_pageSpan=1;
     pageList.push_back(ps);
     m_state->m_numPages = 1;
   }
+}
+
+void SDAParser::createDocument(librevenge::RVNGDrawingInterface *documentInterface)
+{
+  if (!documentInterface) return;
+
+  std::vector<STOFFPageSpan> pageList;
+  updatePageSpans(pageList);
   STOFFGraphicListenerPtr listen(new STOFFGraphicListener(getParserState()->m_listManager, pageList, documentInterface));
   setGraphicListener(listen);
   if (m_state->m_mainGraphic)
@@ -189,12 +220,7 @@ void SDAParser::createDocument(librevenge::RVNGPresentationInterface *documentIn
   if (!documentInterface) return;
 
   std::vector<STOFFPageSpan> pageList;
-  if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages)) {
-    STOFFPageSpan ps(getPageSpan());
-    ps.m_pageSpan=1;
-    pageList.push_back(ps);
-    m_state->m_numPages = 1;
-  }
+  updatePageSpans(pageList);
   STOFFGraphicListenerPtr listen(new STOFFGraphicListener(getParserState()->m_listManager, pageList, documentInterface));
   setGraphicListener(listen);
   if (m_state->m_mainGraphic)
@@ -73,6 +73,12 @@ public:
   {
     m_password=passwd;
   }
+  //! defines the range of pages to send: 1 means the first page, 0 means no limit
+  void setPageRange(int firstPage, int lastPage)
+  {
+    m_pageRange[0]=firstPage;
+    m_pageRange[1]=lastPage;
+  }
   //! checks if the document header is correct (or not)
   bool checkHeader(STOFFHeader *header, bool strict=false) override;
 
@@ -80,12 +86,19 @@ public:
   void parse(librevenge::RVNGDrawingInterface *documentInterface) final;
   // the main presentation parse function
   void parse(librevenge::RVNGPresentationInterface *documentInterface) final;
+  //! parses the document and returns its number of pages, nothing is sent
+  bool countPages(int &numPages);
+  //! returns the number of pages of the document found by the last parse
+  int getNumPages() const;
 
 protected:
   //! creates the listener which will be associated to the document
   void createDocument(librevenge::RVNGDrawingInterface *documentInterface);
   //! creates the listener which will be associated to the document
   void createDocument(librevenge::RVNGPresentationInterface *documentInterface);
+  /** updates the page spans of the pages to send, throws a ParseException if the
+      first page of the range is not in the document */
+  void updatePageSpans(std::vector<STOFFPageSpan> &pageList);
 
   //! parses the different OLE, ...
   bool createZones();
@@ -102,6 +115,8 @@ protected:
   char const *m_password;
   //! the ole parser
   std::shared_ptr<STOFFOLEParser> m_oleParser;
+  //! the first and the last page to send
+  int m_pageRange[2];
   //! the state
   std::shared_ptr<SDAParserInternal::State> m_state;
 private:
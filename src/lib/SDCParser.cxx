@@ -113,7 +113,37 @@ void SDCParser::parse(librevenge::RVNGSpreadsheetInterface *docInterface)
 }
 
 
-bool SDCParser::createZones()
+bool SDCParser::createIndex(librevenge::RVNGBinaryData &index)
+{
+  index.clear();
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  if (!createZones()) return false;
+  StarObjectSpreadsheet::Index sheetIndex;
+  return m_state->m_mainSpreadsheet->createIndex(sheetIndex) && sheetIndex.write(index);
+}
+
+bool SDCParser::readCells(librevenge::RVNGBinaryData const &index, int sheet, int column, STOFFVec2i const &rows,
+                          librevenge::RVNGPropertyListVector &cells, bool checkIndex)
+{
+  cells.clear();
+  StarObjectSpreadsheet::Index sheetIndex;
+  if (!sheetIndex.read(index)) {
+    STOFF_DEBUG_MSG(("SDCParser::readCells: can not read the index\n"));
+    return false;
+  }
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  if (!createZones(false)) return false;
+  return m_state->m_mainSpreadsheet->readCells(sheetIndex, sheet, column, rows, cells, checkIndex);
+}
+
+bool SDCParser::sendColumns(STOFFDocument::ColumnCallback &callback)
+{
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  if (!createZones()) return false;
+  return m_state->m_mainSpreadsheet->sendColumns(callback);
+}
+
+bool SDCParser::createZones(bool parseSpreadsheet)
 {
   m_oleParser.reset(new STOFFOLEParser);
   m_oleParser->parse(getInput());
@@ -130,7 +160,8 @@ bool SDCParser::createZones()
     return false;
   }
   m_state->m_mainSpreadsheet.reset(new StarObjectSpreadsheet(mainObject, false));
-  m_state->m_mainSpreadsheet->parse();
+  if (parseSpreadsheet)
+    m_state->m_mainSpreadsheet->parse();
   return true;
 }
 
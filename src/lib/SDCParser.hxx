@@ -78,13 +78,23 @@ public:
 
   // the main parse function
   void parse(librevenge::RVNGSpreadsheetInterface *documentInterface) override;
+  //! parses the file and creates an index which can be used to retrieve quickly the cells' content
+  bool createIndex(librevenge::RVNGBinaryData &index);
+  /** reads the cells of a sheet's column between rows[0] and rows[1] using an index created by createIndex
+
+      \note only the stream StarCalcDocument is read, the styles, pools, ... are ignored
+   */
+  bool readCells(librevenge::RVNGBinaryData const &index, int sheet, int column, STOFFVec2i const &rows,
+                 librevenge::RVNGPropertyListVector &cells, bool checkIndex);
+  //! parses the file and sends the cells' content column by column
+  bool sendColumns(STOFFDocument::ColumnCallback &callback);
 
 protected:
   //! creates the listener which will be associated to the document
   void createDocument(librevenge::RVNGSpreadsheetInterface *documentInterface);
 
-  //! parses the different OLE, ...
-  bool createZones();
+  //! parses the different OLE, ... (if parseSpreadsheet=false, only creates the main spreadsheet object)
+  bool createZones(bool parseSpreadsheet=true);
 
   //! try to send the spreadsheet
   bool sendSpreadsheet();
@@ -75,6 +75,7 @@ struct State {
 SDWParser::SDWParser(STOFFInputStreamPtr &input, STOFFHeader *header)
   : STOFFTextParser(input, header)
   , m_password(nullptr)
+  , m_skippedRecords()
   , m_oleParser()
   , m_state(new SDWParserInternal::State)
 {
@@ -115,6 +116,42 @@ void SDWParser::parse(librevenge::RVNGTextInterface *docInterface)
 }
 
 
+bool SDWParser::parseText(STOFFDocument::ParagraphCallback &callback)
+{
+  STOFFInputStreamPtr input=getInput();
+  if (!input || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  // do not parse the OLE's structure, only the main zone is needed
+  auto mainInput=input->getSubStreamByName("StarWriterDocument");
+  if (!mainInput) {
+    STOFF_DEBUG_MSG(("SDWParser::parseText: can not find the main zone\n"));
+    return false;
+  }
+  std::shared_ptr<STOFFOLEParser::OleDirectory> mainOle;
+  StarObject mainObject(m_password, m_oleParser, mainOle);
+  StarObjectText text(mainObject, false);
+  return text.readText(mainInput, "StarWriterDocument", callback);
+}
+
+bool SDWParser::parseStatistics(librevenge::RVNGPropertyList &statistics)
+{
+  STOFFInputStreamPtr input=getInput();
+  if (!input || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  auto mainInput=input->getSubStreamByName("StarWriterDocument");
+  if (!mainInput) {
+    STOFF_DEBUG_MSG(("SDWParser::parseStatistics: can not find the main zone\n"));
+    return false;
+  }
+  std::shared_ptr<STOFFOLEParser::OleDirectory> mainOle;
+  StarObject mainObject(m_password, m_oleParser, mainOle);
+  StarObjectText text(mainObject, false);
+  return text.readStatistics(mainInput, "StarWriterDocument", statistics);
+}
+
+long SDWParser::getNumSkippedBytes() const
+{
+  return m_state->m_mainText ? m_state->m_mainText->getNumSkippedBytes() : 0;
+}
+
 bool SDWParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -131,6 +168,7 @@ bool SDWParser::createZones()
     return false;
   }
   m_state->m_mainText.reset(new StarObjectText(mainObject, false));
+  m_state->m_mainText->setSkippedRecords(m_skippedRecords);
   return m_state->m_mainText->parse();
 }
 
@@ -38,6 +38,7 @@
 #ifndef SDW_PARSER
 #  define SDW_PARSER
 
+#include <string>
 #include <vector>
 
 #include "STOFFDebug.hxx"
@@ -73,11 +74,22 @@ public:
   {
     m_password=passwd;
   }
+  //! set the list of ignorable records which must be skipped, see STOFFDocument::ParseOptions
+  void setSkippedRecords(std::string const &records)
+  {
+    m_skippedRecords=records;
+  }
+  //! returns the number of bytes of the records skipped in the main zone
+  long getNumSkippedBytes() const;
   //! checks if the document header is correct (or not)
   bool checkHeader(STOFFHeader *header, bool strict=false) override;
 
   // the main parse function
   void parse(librevenge::RVNGTextInterface *documentInterface) override;
+  //! only retrieves the text of the main zone and sends it to a callback
+  bool parseText(STOFFDocument::ParagraphCallback &callback);
+  //! only retrieves the document statistics (or computes them from the main text)
+  bool parseStatistics(librevenge::RVNGPropertyList &statistics);
 
 protected:
   //! creates the listener which will be associated to the document
@@ -96,6 +108,8 @@ protected:
 
   //! the password
   char const *m_password;
+  //! the list of records to skip
+  std::string m_skippedRecords;
   //! the ole parser
   std::shared_ptr<STOFFOLEParser> m_oleParser;
   //! the state
@@ -36,6 +36,7 @@
  */
 #include <time.h>
 
+#include <atomic>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -470,7 +471,7 @@ librevenge::RVNGPropertyList STOFFCellContent::FormulaInstruction::getPropertyLi
       pList.insert("librevenge:sheet-name",m_sheet.cstr());
     break;
   case F_Index: {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("STOFFCellContent::FormulaInstruction::getPropertyList: impossible to send index data\n"));
       first=false;
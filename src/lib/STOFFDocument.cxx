@@ -46,6 +46,7 @@
 #include "STOFFParser.hxx"
 #include "STOFFPropertyHandler.hxx"
 #include "STOFFSpreadsheetDecoder.hxx"
+#include "StarObject.hxx"
 
 #include <libstaroffice/libstaroffice.hxx>
 
@@ -58,6 +59,63 @@ std::shared_ptr<STOFFTextParser> getTextParserFromHeader(STOFFInputStreamPtr &in
 std::shared_ptr<STOFFSpreadsheetParser> getSpreadsheetParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd);
 STOFFHeader *getHeader(STOFFInputStreamPtr &input, bool strict);
 bool checkHeader(STOFFInputStreamPtr &input, STOFFHeader &header, bool strict);
+
+//! sends the profile stored in the control to the callback
+void sendProfile(libstoff::ParseControl const &control, STOFFDocument::ProfileCallback &callback)
+{
+  for (auto const &it : control.getRecordCounters())
+    callback.insertRecord(it.first.c_str(), it.second.m_count, it.second.m_size, it.second.m_time);
+  for (auto const &it : control.getAllocationCounters())
+    callback.insertAllocation(it.first.c_str(), it.second.m_count, it.second.m_size);
+}
+
+/** calls the parser's parse function, returns STOFF_R_CANCELLED or STOFF_R_MEMORY_LIMIT_ERROR if the
+    parsing has been stopped by the control (the parsers transform the exceptions in ParseException) */
+template <class Parser, class Interface>
+STOFFDocument::Result parse(Parser &parser, Interface *documentInterface, STOFFDocument::ParseOptions const &options, libstoff::ParseControl const &control)
+{
+  try {
+    parser.parse(documentInterface);
+  }
+  catch (...) {
+    if (!control.isStopped()) throw;
+  }
+  if (options.m_profileCallback)
+    sendProfile(control, *options.m_profileCallback);
+  if (control.isMemoryExceeded()) {
+    STOFF_DEBUG_MSG(("STOFFDocumentInternal::parse: the memory budget is exceeded\n"));
+    return STOFFDocument::STOFF_R_MEMORY_LIMIT_ERROR;
+  }
+  if (control.isStopped()) {
+    STOFF_DEBUG_MSG(("STOFFDocumentInternal::parse: the parsing is cancelled\n"));
+    return STOFFDocument::STOFF_R_CANCELLED;
+  }
+  return STOFFDocument::STOFF_R_OK;
+}
+
+/** calls the parse function of a drawing or a presentation parser after defining its
+    range of pages, then sets the number of pages of the document if it is asked (even
+    if the parsing fails) */
+template <class Interface>
+STOFFDocument::Result parseGraphic(STOFFGraphicParser &parser, Interface *documentInterface, STOFFDocument::ParseOptions const &options, libstoff::ParseControl const &control)
+{
+  auto *sdaParser=dynamic_cast<SDAParser *>(&parser);
+  if (sdaParser)
+    sdaParser->setPageRange(options.m_firstPage, options.m_lastPage);
+  if (options.m_numPages)
+    *options.m_numPages=0;
+  try {
+    auto res=parse(parser, documentInterface, options, control);
+    if (sdaParser && options.m_numPages)
+      *options.m_numPages=sdaParser->getNumPages();
+    return res;
+  }
+  catch (...) {
+    if (sdaParser && options.m_numPages)
+      *options.m_numPages=sdaParser->getNumPages();
+    throw;
+  }
+}
 }
 
 STOFFDocument::Confidence STOFFDocument::isFileFormatSupported(librevenge::RVNGInputStream *input, Kind &kind)
@@ -90,20 +148,62 @@ catch (...)
   return STOFF_C_NONE;
 }
 
+STOFFDocument::Confidence STOFFDocument::isFileFormatSupportedFast(librevenge::RVNGInputStream *input, Kind &kind, int &version)
+try
+{
+  kind = STOFF_K_UNKNOWN;
+  version = 0;
+
+  if (!input) {
+    STOFF_DEBUG_MSG(("STOFFDocument::isFileFormatSupportedFast(): no input\n"));
+    return STOFF_C_NONE;
+  }
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  STOFFHeader header;
+  if (!STOFFHeader::constructHeaderFromDirectory(ip, header))
+    return STOFF_C_NONE;
+  kind = static_cast<STOFFDocument::Kind>(header.getKind());
+  version = header.getVersion();
+  return header.isEncrypted() ? STOFF_C_SUPPORTED_ENCRYPTION : STOFF_C_EXCELLENT;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::isFileFormatSupportedFast: exception catched\n"));
+  kind = STOFF_K_UNKNOWN;
+  version = 0;
+  return STOFF_C_NONE;
+}
+
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return STOFF_R_UNKNOWN_ERROR;
 
+  libstoff::ParseControl control(options.m_cancel, options.m_maxDuration, options.m_maxMemory, options.m_usedMemory, options.m_profileCallback!=nullptr);
   STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
   auto parser=STOFFDocumentInternal::getGraphicParserFromHeader(ip, header.get(), password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-  return STOFF_R_OK;
+  return STOFFDocumentInternal::parseGraphic(*parser, documentInterface, options, control);
+}
+catch (libstoff::CancelledException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+  return STOFF_R_CANCELLED;
+}
+catch (libstoff::MemoryException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the memory budget is exceeded\n"));
+  return STOFF_R_MEMORY_LIMIT_ERROR;
 }
 catch (libstoff::FileException)
 {
@@ -128,19 +228,34 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return STOFF_R_UNKNOWN_ERROR;
 
+  libstoff::ParseControl control(options.m_cancel, options.m_maxDuration, options.m_maxMemory, options.m_usedMemory, options.m_profileCallback!=nullptr);
   STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
   auto parser=STOFFDocumentInternal::getPresentationParserFromHeader(ip, header.get(), password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-  return STOFF_R_OK;
+  return STOFFDocumentInternal::parseGraphic(*parser, documentInterface, options, control);
+}
+catch (libstoff::CancelledException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+  return STOFF_R_CANCELLED;
+}
+catch (libstoff::MemoryException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the memory budget is exceeded\n"));
+  return STOFF_R_MEMORY_LIMIT_ERROR;
 }
 catch (libstoff::FileException)
 {
@@ -164,20 +279,76 @@ catch (...)
   return STOFF_R_UNKNOWN_ERROR;
 }
 
+STOFFDocument::Result STOFFDocument::countPages(librevenge::RVNGInputStream *input, int &numPages, char const *password)
+try
+{
+  numPages=0;
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
+  std::shared_ptr<STOFFGraphicParser> parser;
+  if (header->getKind()==STOFFDocument::STOFF_K_PRESENTATION)
+    parser=STOFFDocumentInternal::getPresentationParserFromHeader(ip, header.get(), password);
+  else
+    parser=STOFFDocumentInternal::getGraphicParserFromHeader(ip, header.get(), password);
+  auto *sdaParser=dynamic_cast<SDAParser *>(parser.get());
+  if (!sdaParser) return STOFF_R_UNKNOWN_ERROR;
+  return sdaParser->countPages(numPages) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::countPages: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::countPages: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::countPages: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::countPages: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return STOFF_R_UNKNOWN_ERROR;
 
+  libstoff::ParseControl control(options.m_cancel, options.m_maxDuration, options.m_maxMemory, options.m_usedMemory, options.m_profileCallback!=nullptr);
   STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
   auto parser=STOFFDocumentInternal::getSpreadsheetParserFromHeader(ip, header.get(), password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-  return STOFF_R_OK;
+  return STOFFDocumentInternal::parse(*parser, documentInterface, options, control);
+}
+catch (libstoff::CancelledException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+  return STOFF_R_CANCELLED;
+}
+catch (libstoff::MemoryException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the memory budget is exceeded\n"));
+  return STOFF_R_MEMORY_LIMIT_ERROR;
 }
 catch (libstoff::FileException)
 {
@@ -202,20 +373,42 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, ParseOptions(), password);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, ParseOptions const &options, char const *password)
 try
 {
   if (!input)
     return STOFF_R_UNKNOWN_ERROR;
 
+  libstoff::ParseControl control(options.m_cancel, options.m_maxDuration, options.m_maxMemory, options.m_usedMemory, options.m_profileCallback!=nullptr);
   STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
   auto parser=STOFFDocumentInternal::getTextParserFromHeader(ip, header.get(), password);
   if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-
-  return STOFF_R_OK;
+  auto *sdwParser=dynamic_cast<SDWParser *>(parser.get());
+  if (sdwParser && options.m_skippedTextRecords)
+    sdwParser->setSkippedRecords(options.m_skippedTextRecords);
+  if (options.m_skippedTextBytes)
+    *options.m_skippedTextBytes=0;
+  auto res=STOFFDocumentInternal::parse(*parser, documentInterface, options, control);
+  if (sdwParser && options.m_skippedTextBytes)
+    *options.m_skippedTextBytes=static_cast<unsigned long>(sdwParser->getNumSkippedBytes());
+  return res;
+}
+catch (libstoff::CancelledException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+  return STOFF_R_CANCELLED;
+}
+catch (libstoff::MemoryException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: the memory budget is exceeded\n"));
+  return STOFF_R_MEMORY_LIMIT_ERROR;
 }
 catch (libstoff::FileException)
 {
@@ -239,6 +432,241 @@ catch (...)
   return STOFF_R_UNKNOWN_ERROR;
 }
 
+STOFFDocument::Result STOFFDocument::parseText(librevenge::RVNGInputStream *input, ParagraphCallback &callback, char const *password)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  STOFFHeader header;
+  if (!STOFFHeader::constructHeaderFromDirectory(ip, header) || header.getKind()!=STOFF_K_TEXT)
+    return STOFF_R_UNKNOWN_ERROR;
+  SDWParser parser(ip, &header);
+  if (password) parser.setDocumentPassword(password);
+  return parser.parseText(callback) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseText: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseText: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseText: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseText: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseStatistics(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &statistics, char const *password)
+try
+{
+  statistics.clear();
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  STOFFHeader header;
+  if (!STOFFHeader::constructHeaderFromDirectory(ip, header) || header.getKind()!=STOFF_K_TEXT)
+    return STOFF_R_UNKNOWN_ERROR;
+  SDWParser parser(ip, &header);
+  if (password) parser.setDocumentPassword(password);
+  return parser.parseStatistics(statistics) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseStatistics: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseStatistics: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseStatistics: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseStatistics: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData)
+try
+{
+  metaData.clear();
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  STOFFHeader header;
+  if (!STOFFHeader::constructHeaderFromDirectory(ip, header))
+    return STOFF_R_UNKNOWN_ERROR;
+  if (header.getKind()!=STOFF_K_GRAPHIC) // a sdg file does not contain any meta data
+    StarObject::readMetaData(ip, metaData);
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseMetaData: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &data, librevenge::RVNGString &mimeType)
+try
+{
+  data.clear();
+  mimeType.clear();
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  STOFFHeader header;
+  if (!STOFFHeader::constructHeaderFromDirectory(ip, header))
+    return STOFF_R_UNKNOWN_ERROR;
+  std::string type;
+  if (header.getKind()==STOFF_K_GRAPHIC || !StarObject::readThumbnail(ip, data, type))
+    return STOFF_R_PARSE_ERROR;
+  mimeType=type.c_str();
+  return STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseThumbnail: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::createSpreadsheetIndex(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &index, char const *password)
+try
+{
+  index.clear();
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get() || header->getKind()!=STOFF_K_SPREADSHEET) return STOFF_R_UNKNOWN_ERROR;
+  SDCParser parser(ip, header.get());
+  if (password) parser.setDocumentPassword(password);
+  return parser.createIndex(index) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::createSpreadsheetIndex: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::createSpreadsheetIndex: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::createSpreadsheetIndex: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::createSpreadsheetIndex: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseSpreadsheetCells(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData const &index,
+    int sheet, int column, int minRow, int maxRow,
+    librevenge::RVNGPropertyListVector &cells, char const *password, bool checkIndex)
+try
+{
+  cells.clear();
+  if (!input || minRow>maxRow)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get() || header->getKind()!=STOFF_K_SPREADSHEET) return STOFF_R_UNKNOWN_ERROR;
+  SDCParser parser(ip, header.get());
+  if (password) parser.setDocumentPassword(password);
+  return parser.readCells(index, sheet, column, STOFFVec2i(minRow, maxRow), cells, checkIndex) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetCells: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetCells: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetCells: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetCells: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
+STOFFDocument::Result STOFFDocument::parseSpreadsheetColumns(librevenge::RVNGInputStream *input, ColumnCallback &callback, char const *password)
+try
+{
+  if (!input)
+    return STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+
+  if (!header.get() || header->getKind()!=STOFF_K_SPREADSHEET) return STOFF_R_UNKNOWN_ERROR;
+  SDCParser parser(ip, header.get());
+  if (password) parser.setDocumentPassword(password);
+  return parser.sendColumns(callback) ? STOFF_R_OK : STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetColumns: File exception trapped\n"));
+  return STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetColumns: Parse exception trapped\n"));
+  return STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetColumns: Parse password trapped\n"));
+  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parseSpreadsheetColumns: Unknown exception trapped\n"));
+  return STOFF_R_UNKNOWN_ERROR;
+}
+
 bool STOFFDocument::decodeGraphic(librevenge::RVNGBinaryData const &binary, librevenge::RVNGDrawingInterface *paintInterface)
 try
 {
@@ -37,11 +37,14 @@
 
 #include <string.h>
 #include <iostream>
+#include <map>
+#include <set>
 
 #include "libstaroffice_internal.hxx"
 
 #include "STOFFEntry.hxx"
 #include "STOFFInputStream.hxx"
+#include "STOFFOLEParser.hxx"
 
 #include "STOFFHeader.hxx"
 
@@ -105,4 +108,347 @@ std::vector<STOFFHeader> STOFFHeader::constructHeader(STOFFInputStreamPtr input)
   }
   return res;
 }
+
+////////////////////////////////////////////////////////////
+// fast check: only read the compound file's header and directory
+////////////////////////////////////////////////////////////
+namespace STOFFHeaderInternal
+{
+//! Internal: a directory entry of a compound file
+struct OleEntry {
+  //! constructor
+  OleEntry()
+    : m_name("")
+    , m_type(0)
+    , m_left(0xFFFFFFFF)
+    , m_right(0xFFFFFFFF)
+    , m_child(0xFFFFFFFF)
+    , m_clsId(0)
+    , m_start(0)
+    , m_size(0)
+  {
+  }
+  //! the entry name (only the low byte of each character is kept)
+  std::string m_name;
+  //! the entry type: 1: storage, 2: stream, 5: root
+  int m_type;
+  //! the left sibling
+  unsigned long m_left;
+  //! the right sibling
+  unsigned long m_right;
+  //! the first child
+  unsigned long m_child;
+  //! the first 32 bits of the class id
+  unsigned long m_clsId;
+  //! the first sector
+  unsigned long m_start;
+  //! the stream size
+  unsigned long m_size;
+};
+
+/** Internal: a minimal compound file reader which only reads the
+    header, the FAT sectors which are needed to follow the directory
+    chain and the directory sectors, ie. it never asks librevenge to
+    build a sub-stream.
+ */
+class OleDirectoryReader
+{
+public:
+  //! constructor
+  explicit OleDirectoryReader(STOFFInputStreamPtr input)
+    : m_input(input)
+    , m_sectorShift(9)
+    , m_miniCutoff(4096)
+    , m_firstDifatSector(0xFFFFFFFE)
+    , m_difatList()
+    , m_directorySectorList()
+  {
+  }
+  //! try to read the header
+  bool readHeader();
+  //! try to read the entries of the root storage, returns the root entry
+  bool readRootEntries(OleEntry &root, std::map<std::string, OleEntry> &children);
+  //! try to read the first bytes of a stream
+  bool readStreamBegin(OleEntry const &root, OleEntry const &entry, unsigned char *buffer, int num);
+protected:
+  //! returns the sector size
+  unsigned long getSectorSize() const
+  {
+    return 1UL<<m_sectorShift;
+  }
+  //! returns the number of sector of the file
+  unsigned long getNumSectors() const
+  {
+    return static_cast<unsigned long>(m_input->size())>>m_sectorShift;
+  }
+  //! returns the position of a sector or -1
+  long getSectorPosition(unsigned long sector) const
+  {
+    if (sector>=getNumSectors()) return -1;
+    return long((sector+1)<<m_sectorShift);
+  }
+  //! reads a 4 bytes value at a given position
+  bool readULong(long pos, unsigned long &val)
+  {
+    if (pos<0 || !m_input->checkPosition(pos+4) || m_input->seek(pos, librevenge::RVNG_SEEK_SET)!=0)
+      return false;
+    val=m_input->readULong(4);
+    return true;
+  }
+  //! returns the sector which follows a sector
+  bool getNextSector(unsigned long sector, unsigned long &next);
+  //! try to read a directory entry
+  bool readEntry(unsigned long id, OleEntry &entry);
+  //! the input
+  STOFFInputStreamPtr m_input;
+  //! the sector shift
+  int m_sectorShift;
+  //! the mini stream cutoff
+  unsigned long m_miniCutoff;
+  //! the next DIFAT sector to read
+  unsigned long m_firstDifatSector;
+  //! the list of FAT sectors found so far
+  std::vector<unsigned long> m_difatList;
+  //! the list of directory sectors found so far
+  std::vector<unsigned long> m_directorySectorList;
+};
+
+bool OleDirectoryReader::readHeader()
+{
+  if (!m_input || m_input->size()<512)
+    return false;
+  m_input->setReadInverted(true);
+  m_input->seek(0, librevenge::RVNG_SEEK_SET);
+  if (m_input->readULong(4)!=0xE011CFD0 || m_input->readULong(4)!=0xE11AB1A1)
+    return false;
+  m_input->seek(28, librevenge::RVNG_SEEK_SET);
+  if (m_input->readULong(2)!=0xFFFE)
+    return false;
+  m_sectorShift=int(m_input->readULong(2));
+  if (m_sectorShift!=9 && m_sectorShift!=12) {
+    STOFF_DEBUG_MSG(("STOFFHeaderInternal::OleDirectoryReader::readHeader: unexpected sector shift\n"));
+    return false;
+  }
+  m_input->seek(48, librevenge::RVNG_SEEK_SET);
+  m_directorySectorList.push_back(m_input->readULong(4));
+  m_input->seek(56, librevenge::RVNG_SEEK_SET);
+  m_miniCutoff=m_input->readULong(4);
+  m_input->seek(68, librevenge::RVNG_SEEK_SET);
+  m_firstDifatSector=m_input->readULong(4);
+  m_input->seek(76, librevenge::RVNG_SEEK_SET);
+  for (int i=0; i<109; ++i) {
+    auto fat=m_input->readULong(4);
+    if (fat>=0xFFFFFFFA) break;
+    m_difatList.push_back(fat);
+  }
+  return true;
+}
+
+bool OleDirectoryReader::getNextSector(unsigned long sector, unsigned long &next)
+{
+  unsigned long const numByFat=getSectorSize()/4;
+  auto fatId=size_t(sector/numByFat);
+  // retrieve the FAT sectors stored in the DIFAT sectors
+  while (fatId>=m_difatList.size() && m_firstDifatSector<0xFFFFFFFA) {
+    long pos=getSectorPosition(m_firstDifatSector);
+    if (pos<0) return false;
+    for (unsigned long i=0; i+1<numByFat; ++i) {
+      unsigned long fat;
+      if (!readULong(pos+long(4*i), fat)) return false;
+      if (fat>=0xFFFFFFFA) break;
+      m_difatList.push_back(fat);
+    }
+    if (!readULong(pos+long(4*(numByFat-1)), m_firstDifatSector) || m_difatList.size()>getNumSectors())
+      return false;
+  }
+  if (fatId>=m_difatList.size()) return false;
+  long pos=getSectorPosition(m_difatList[fatId]);
+  return pos>=0 && readULong(pos+long(4*(sector%numByFat)), next);
+}
+
+bool OleDirectoryReader::readEntry(unsigned long id, OleEntry &entry)
+{
+  unsigned long const numBySector=getSectorSize()/128;
+  auto sectorId=size_t(id/numBySector);
+  while (sectorId>=m_directorySectorList.size()) {
+    unsigned long next;
+    if (m_directorySectorList.size()>getNumSectors() || !getNextSector(m_directorySectorList.back(), next) || next>=0xFFFFFFFA)
+      return false;
+    m_directorySectorList.push_back(next);
+  }
+  long pos=getSectorPosition(m_directorySectorList[sectorId]);
+  if (pos<0) return false;
+  pos+=long(128*(id%numBySector));
+  if (!m_input->checkPosition(pos+128)) return false;
+  m_input->seek(pos+64, librevenge::RVNG_SEEK_SET);
+  auto nameSize=int(m_input->readULong(2));
+  entry=OleEntry();
+  entry.m_type=int(m_input->readULong(1));
+  m_input->seek(1, librevenge::RVNG_SEEK_CUR);
+  entry.m_left=m_input->readULong(4);
+  entry.m_right=m_input->readULong(4);
+  entry.m_child=m_input->readULong(4);
+  entry.m_clsId=m_input->readULong(4);
+  m_input->seek(pos+116, librevenge::RVNG_SEEK_SET);
+  entry.m_start=m_input->readULong(4);
+  entry.m_size=m_input->readULong(4);
+  if (nameSize>64) return false;
+  m_input->seek(pos, librevenge::RVNG_SEEK_SET);
+  for (int c=0; c+2<nameSize; c+=2) {
+    auto ch=m_input->readULong(2);
+    entry.m_name+=char(ch<0x100 ? ch : '_');
+  }
+  return true;
+}
+
+bool OleDirectoryReader::readRootEntries(OleEntry &root, std::map<std::string, OleEntry> &children)
+{
+  if (!readEntry(0, root) || root.m_type!=5)
+    return false;
+  // the children are stored in a binary tree
+  std::vector<unsigned long> toDo(1, root.m_child);
+  std::set<unsigned long> seen;
+  while (!toDo.empty()) {
+    auto id=toDo.back();
+    toDo.pop_back();
+    if (id>=0xFFFFFFFA) continue;
+    if (seen.find(id)!=seen.end() || seen.size()>1000) {
+      STOFF_DEBUG_MSG(("STOFFHeaderInternal::OleDirectoryReader::readRootEntries: the directory tree seems bad\n"));
+      return false;
+    }
+    seen.insert(id);
+    OleEntry entry;
+    if (!readEntry(id, entry)) return false;
+    toDo.push_back(entry.m_left);
+    toDo.push_back(entry.m_right);
+    children[entry.m_name]=entry;
+  }
+  return true;
+}
+
+bool OleDirectoryReader::readStreamBegin(OleEntry const &root, OleEntry const &entry, unsigned char *buffer, int num)
+{
+  if (entry.m_type!=2 || num<=0 || entry.m_size<static_cast<unsigned long>(num) || num>64)
+    return false;
+  unsigned long sector=entry.m_start;
+  unsigned long offset=0;
+  if (entry.m_size<m_miniCutoff) {
+    // the stream is stored in the mini stream
+    sector=root.m_start;
+    offset=entry.m_start*64;
+    for (unsigned long i=0; i<(offset>>m_sectorShift); ++i) {
+      if (i>getNumSectors() || !getNextSector(sector, sector)) return false;
+    }
+    offset&=getSectorSize()-1;
+  }
+  long pos=getSectorPosition(sector);
+  if (pos<0 || !m_input->checkPosition(pos+long(offset)+num)) return false;
+  m_input->seek(pos+long(offset), librevenge::RVNG_SEEK_SET);
+  for (int i=0; i<num; ++i)
+    buffer[i]=static_cast<unsigned char>(m_input->readULong(1));
+  return true;
+}
+
+//! returns the StarOffice version (3, 4, 5) and the kind corresponding to the first 32 bits of a class id or 0
+int getVersionFromClsId(unsigned long clsId, STOFFDocument::Kind &kind)
+{
+  switch (clsId) {
+  case 0xDC5C7E40:
+    kind=STOFFDocument::STOFF_K_TEXT;
+    return 3;
+  case 0x8B04E9B0:
+    kind=STOFFDocument::STOFF_K_TEXT;
+    return 4;
+  case 0xC20CF9D1:
+    kind=STOFFDocument::STOFF_K_TEXT;
+    return 5;
+  case 0x3F543FA0:
+    kind=STOFFDocument::STOFF_K_SPREADSHEET;
+    return 3;
+  case 0x6361D441:
+    kind=STOFFDocument::STOFF_K_SPREADSHEET;
+    return 4;
+  case 0xC6A5B861:
+    kind=STOFFDocument::STOFF_K_SPREADSHEET;
+    return 5;
+  case 0xAF10AAE0:
+    kind=STOFFDocument::STOFF_K_PRESENTATION;
+    return 3;
+  case 0x012D3CC0:
+    kind=STOFFDocument::STOFF_K_PRESENTATION;
+    return 4;
+  case 0x565C7221:
+    kind=STOFFDocument::STOFF_K_PRESENTATION;
+    return 5;
+  case 0x2E8905A0:
+    kind=STOFFDocument::STOFF_K_DRAW;
+    return 5;
+  default:
+    break;
+  }
+  return 0;
+}
+}
+
+bool STOFFHeader::constructHeaderFromDirectory(STOFFInputStreamPtr input, STOFFHeader &header)
+{
+  header=STOFFHeader(0, STOFFDocument::STOFF_K_UNKNOWN);
+  if (!input || !input->hasDataFork() || input->size() < 8)
+    return false;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  input->setReadInverted(false);
+  if (input->readULong(4)==0x53474133) {// SGA3
+    header.reset(1, STOFFDocument::STOFF_K_GRAPHIC);
+    return true;
+  }
+  STOFFHeaderInternal::OleDirectoryReader reader(input);
+  STOFFHeaderInternal::OleEntry root;
+  std::map<std::string, STOFFHeaderInternal::OleEntry> children;
+  if (!reader.readHeader() || !reader.readRootEntries(root, children))
+    return false;
+  STOFFDocument::Kind clsKind=STOFFDocument::STOFF_K_UNKNOWN;
+  int version=STOFFHeaderInternal::getVersionFromClsId(root.m_clsId, clsKind);
+  unsigned char buffer[12];
+  auto it=children.find("StarWriterDocument");
+  if (it!=children.end()) {
+    header.reset(version, STOFFDocument::STOFF_K_TEXT);
+    if (!reader.readStreamBegin(root, it->second, buffer, 12))
+      return false;
+    // SW3HDR, SW4HDR or SW5HDR
+    if (buffer[0]!='S' || buffer[1]!='W' || buffer[3]!='H')
+      return false;
+    if (!version && buffer[2]>='3' && buffer[2]<='5')
+      header.setVersion(int(buffer[2]-'0'));
+    header.setEncrypted((buffer[10]&8)!=0);
+    return true;
+  }
+  it=children.find("StarCalcDocument");
+  if (it!=children.end()) {
+    header.reset(version, STOFFDocument::STOFF_K_SPREADSHEET);
+    if (!reader.readStreamBegin(root, it->second, buffer, 2))
+      return false;
+    header.setEncrypted(buffer[1]!=0x42);
+    return true;
+  }
+  it=children.find("StarDrawDocument");
+  bool isPres=false;
+  if (it==children.end()) {
+    it=children.find("StarDrawDocument3");
+    if (it==children.end())
+      return false;
+    if (clsKind==STOFFDocument::STOFF_K_PRESENTATION)
+      isPres=true;
+    else if (clsKind==STOFFDocument::STOFF_K_UNKNOWN) {
+      // unknown class id, look at the clip name, ie. read the small CompObj stream
+      STOFFOLEParser oleParser;
+      std::string clipName;
+      isPres=oleParser.getCompObjName(input, clipName) && clipName.substr(0,11)=="StarImpress";
+    }
+  }
+  header.reset(version, isPres ? STOFFDocument::STOFF_K_PRESENTATION : STOFFDocument::STOFF_K_DRAW);
+  if (!reader.readStreamBegin(root, it->second, buffer, 2))
+    return false;
+  header.setEncrypted(buffer[0]!=0x72 || buffer[1]!=0x44);
+  return true;
+}
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
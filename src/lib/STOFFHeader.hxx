@@ -72,6 +72,11 @@ public:
   \note this check phase can only be partial ; ie. we only test the first bytes of the file and/or the existence of some oles. This explains that STOFFDocument implements a more complete test to recognize the difference Mac Files which share the same type of header...
   */
   static std::vector<STOFFHeader> constructHeader(STOFFInputStreamPtr input);
+  /** tests the input file using only the compound file's directory entries and the first bytes of the main stream,
+      ie. without asking librevenge to create any sub-stream.
+
+      \note the version is set to 3, 4 or 5 if it can be retrieved, 0 if not */
+  static bool constructHeaderFromDirectory(STOFFInputStreamPtr input, STOFFHeader &header);
 
   //! resets the data
   void reset(int vers, Kind kind = STOFFDocument::STOFF_K_TEXT)
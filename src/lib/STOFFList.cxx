@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
 
@@ -150,7 +151,7 @@ bool STOFFList::addTo(int level, librevenge::RVNGPropertyList &pList) const
 
   if (getId()==-1) {
     STOFF_DEBUG_MSG(("STOFFList::addTo: the list id is not set\n"));
-    static int falseId = 1000;
+    static std::atomic<int> falseId(1000);
     setId(falseId+=2);
   }
   pList.insert("librevenge:list-id", getId());
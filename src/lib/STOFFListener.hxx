@@ -34,6 +34,7 @@
 #ifndef STOFF_LISTENER_H
 #define STOFF_LISTENER_H
 
+#include <atomic>
 #include <vector>
 
 #include <librevenge/librevenge.h>
@@ -222,7 +223,7 @@ public:
                                     STOFFGraphicShape const &/*shape*/,
                                     STOFFGraphicStyle const &frameStyle=STOFFGraphicStyle())
   {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("STOFFListener::insertTextBoxInShape: umimplemented, revert to basic insertTextBox\n"));
       first=false;
@@ -84,6 +84,8 @@
 #include <librevenge/librevenge.h>
 
 #include "STOFFPosition.hxx"
+#include "StarEncoding.hxx"
+
 #include "STOFFOLEParser.hxx"
 
 //////////////////////////////////////////////////
@@ -98,6 +100,8 @@ struct State {
   State()
     : m_oleList()
     , m_unknownOLEs()
+    , m_pictureStore()
+    , m_nameToEmbeddedPictureMap()
     , m_mapCls()
   {
   }
@@ -113,6 +117,10 @@ struct State {
   std::vector<std::shared_ptr<STOFFOLEParser::OleDirectory> > m_oleList;
   //! list of ole which can not be parsed
   std::vector<std::string> m_unknownOLEs;
+  //! the store of the decoded pictures' data
+  STOFFPictureStore m_pictureStore;
+  //! a map name to the decoded embedded pictures
+  std::map<std::string, STOFFEmbeddedObject> m_nameToEmbeddedPictureMap;
 protected:
   /** initialise a map CLSId <-> name */
   void initCLSMap();
@@ -259,6 +267,24 @@ std::shared_ptr<STOFFOLEParser::OleDirectory> STOFFOLEParser::getDirectory(std::
   return std::shared_ptr<STOFFOLEParser::OleDirectory>();
 }
 
+bool STOFFOLEParser::getEmbeddedPicture(std::string const &name, STOFFEmbeddedObject &picture) const
+{
+  auto it=m_state->m_nameToEmbeddedPictureMap.find(name);
+  if (it==m_state->m_nameToEmbeddedPictureMap.end())
+    return false;
+  auto const &stored=it->second;
+  for (size_t i=0; i<stored.m_dataList.size(); ++i)
+    picture.add(stored.m_dataList[i], i<stored.m_typeList.size() ? stored.m_typeList[i] : "image/pict");
+  return true;
+}
+
+void STOFFOLEParser::storeEmbeddedPicture(std::string const &name, STOFFEmbeddedObject &picture)
+{
+  for (auto &data : picture.m_dataList)
+    data=m_state->m_pictureStore.get(data);
+  m_state->m_nameToEmbeddedPictureMap[name]=picture;
+}
+
 // parsing
 bool STOFFOLEParser::parse(STOFFInputStreamPtr file)
 {
@@ -321,13 +347,17 @@ bool STOFFOLEParser::parse(STOFFInputStreamPtr file)
       }
 
       ole->setReadInverted(true);
-      if (isOlePres(ole, base) && readOlePres(ole, content))
-        continue;
-      if (isOle10Native(ole, base) && readOle10Native(ole, content))
-        // small size can be a symptom that this is a link
-        continue;
-      if (readContents(ole, content) || readCONTENTS(ole, content))
+      if ((isOlePres(ole, base) && readOlePres(ole, content)) ||
+          // small size can be a symptom that this is a link
+          (isOle10Native(ole, base) && readOle10Native(ole, content)) ||
+          readContents(ole, content) || readCONTENTS(ole, content)) {
+        // share the data of the identical replacement pictures
+        librevenge::RVNGBinaryData data;
+        std::string type;
+        if (content.getImageData(data, type))
+          content.setImageData(m_state->m_pictureStore.get(data), type);
         continue;
+      }
       libstoff::DebugFile asciiFile(ole);
       asciiFile.open(oleName);
 
@@ -418,8 +448,19 @@ bool STOFFOLEParser::readOle(STOFFInputStreamPtr ip, std::string const &oleName,
   return true;
 }
 
+bool STOFFOLEParser::getSummaryInformation(STOFFInputStreamPtr file, librevenge::RVNGPropertyList &metaData)
+{
+  if (!file.get() || !file->isStructured()) return false;
+  auto ole = file->getSubStreamByName("\005SummaryInformation");
+  if (!ole) return false;
+  ole->setReadInverted(true);
+  libstoff::DebugFile asciiFile(ole);
+  asciiFile.open("SummaryInformation");
+  return readSummaryInformation(ole, "SummaryInformation", asciiFile, &metaData);
+}
+
 bool STOFFOLEParser::readSummaryInformation(STOFFInputStreamPtr input, std::string const &oleName,
-    libstoff::DebugFile &ascii)
+    libstoff::DebugFile &ascii, librevenge::RVNGPropertyList *metaData)
 {
   if (oleName!="SummaryInformation") return false;
   input->seek(0, librevenge::RVNG_SEEK_SET);
@@ -506,6 +547,15 @@ bool STOFFOLEParser::readSummaryInformation(STOFFInputStreamPtr input, std::stri
   ascii.addPos(pos);
   ascii.addNote(f.str().c_str());
 
+  // the codepage (id=1) gives the encoding of the strings
+  auto encoding=StarEncoding::E_MS_1252;
+  for (auto const &posToType : posToTypeMap) {
+    if (posToType.second!=1) continue;
+    input->seek(posToType.first, librevenge::RVNG_SEEK_SET);
+    if (input->readULong(4)==2)
+      encoding=StarEncoding::getEncodingForWindowsCodePage(int(input->readULong(2)));
+    break;
+  }
   for (auto const posToType : posToTypeMap) {
     pos=posToType.first;
     input->seek(pos, librevenge::RVNG_SEEK_SET);
@@ -521,12 +571,33 @@ bool STOFFOLEParser::readSummaryInformation(STOFFInputStreamPtr input, std::stri
         ascii.addNote(f.str().c_str());
         continue;
       }
-      std::string text("");
-      for (long c=0; c < sSz; ++c) text+=char(input->readULong(1));
-      f << text;
+      std::vector<uint8_t> text;
+      for (long c=0; c < sSz; ++c) text.push_back(static_cast<uint8_t>(input->readULong(1)));
+      while (!text.empty() && text.back()==0) text.pop_back();
+      std::vector<uint32_t> finalText;
+      std::vector<size_t> srcPositions;
+      if (StarEncoding::convert(text, encoding, finalText, srcPositions)) {
+        auto string=libstoff::getString(finalText);
+        f << string.cstr();
+        static char const *attribNames[]= {
+          "dc:title", "dc:subject", "meta:initial-creator", "meta:keywords", "dc:description", "", "dc:creator"
+        };
+        int const id=posToType.second;
+        if (metaData && !string.empty() && id>=2 && id<=8 && !std::string(attribNames[id-2]).empty())
+          metaData->insert(attribNames[id-2], string);
+      }
     }
+    else if (type==2)
+      f << "val=" << input->readULong(2) << ",";
     else if (type==0x40) {
-      f << "dateTime,"; // readme 8 byte
+      f << "dateTime,";
+      // a FILETIME: the number of 100 ns since 1601/01/01
+      auto low=input->readULong(4);
+      auto high=input->readULong(4);
+      std::string dateTime;
+      int const id=posToType.second;
+      if (metaData && (id==12 || id==13) && (low || high) && libstoff::convertFileTimeToDateTime(low, high, dateTime))
+        metaData->insert(id==12 ? "meta:creation-date" : "dc:date", dateTime.c_str());
     }
     else {
       STOFF_DEBUG_MSG(("STOFFOLEParser::readSummaryInformation: find unknown type\n"));
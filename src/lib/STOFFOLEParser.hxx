@@ -104,6 +104,13 @@ public:
   std::shared_ptr<OleDirectory> getDirectory(std::string const &dir);
   //! returns the main compobj program name
   bool getCompObjName(STOFFInputStreamPtr fileInput, std::string &programName);
+  //! tries to read the meta data stored in the "SummaryInformation" zone of a file
+  static bool getSummaryInformation(STOFFInputStreamPtr fileInput, librevenge::RVNGPropertyList &metaData);
+  //! appends the picture of "EmbeddedPictures/name" to picture if it has already been decoded
+  bool getEmbeddedPicture(std::string const &name, STOFFEmbeddedObject &picture) const;
+  /** stores the decoded picture of "EmbeddedPictures/name", its data are replaced by
+      the data of the identical pictures already decoded */
+  void storeEmbeddedPicture(std::string const &name, STOFFEmbeddedObject &picture);
 
   /** structure use to store an object content */
   struct OleContent {
@@ -233,9 +240,9 @@ public:
   };
 
 protected:
-  //! the summary information
+  //! the summary information, if metaData is set, fills it with the title, author, ...
   static bool readSummaryInformation(STOFFInputStreamPtr input, std::string const &oleName,
-                                     libstoff::DebugFile &ascii);
+                                     libstoff::DebugFile &ascii, librevenge::RVNGPropertyList *metaData=nullptr);
   //!  parse the "CompObj" contains : UserType,ClipName,ProgIdName
   bool readCompObj(STOFFInputStreamPtr ip, OleDirectory &directory);
   //!  the "Ole" small structure : unknown contain
@@ -133,6 +133,9 @@ bool STOFFPropertyHandlerEncoder::getData(librevenge::RVNGBinaryData &data)
   data.clear();
   std::string d=m_f.str();
   if (d.length() == 0) return false;
+  // the copy belongs to the caller, only the peak is charged
+  libstoff::MemoryCharge memoryCharge;
+  memoryCharge.charge("STOFFPropertyHandlerEncoder", d.length());
   data.append(reinterpret_cast<const unsigned char *>(d.c_str()), d.length());
   return true;
 }
@@ -24,6 +24,8 @@
 
 #include <librevenge-stream/librevenge-stream.h>
 
+#include "libstaroffice_internal.hxx"
+
 #include "STOFFStringStream.hxx"
 
 //! internal data of a STOFFStringStream
@@ -40,15 +42,20 @@ public:
   std::vector<unsigned char> m_buffer;
   //! the stream offset
   long m_offset;
+  //! the memory charged for the buffer, given back when the stream is destroyed
+  libstoff::MemoryCharge m_memoryCharge;
 private:
   STOFFStringStreamPrivate(const STOFFStringStreamPrivate &);
   STOFFStringStreamPrivate &operator=(const STOFFStringStreamPrivate &);
 };
 
 STOFFStringStreamPrivate::STOFFStringStreamPrivate(const unsigned char *data, unsigned dataSize)
-  : m_buffer(dataSize)
+  : m_buffer()
   , m_offset(0)
+  , m_memoryCharge()
 {
+  m_memoryCharge.charge("STOFFStringStream", dataSize);
+  m_buffer.resize(dataSize);
   std::memcpy(&m_buffer[0], data, dataSize);
 }
 
@@ -59,6 +66,7 @@ STOFFStringStreamPrivate::~STOFFStringStreamPrivate()
 void STOFFStringStreamPrivate::append(const unsigned char *data, unsigned dataSize)
 {
   if (!dataSize) return;
+  m_memoryCharge.charge("STOFFStringStream", dataSize);
   size_t actualSize=m_buffer.size();
   m_buffer.resize(actualSize+size_t(dataSize));
   std::memcpy(&m_buffer[actualSize], data, dataSize);
@@ -38,6 +38,7 @@
  * the librevenge::RVNGTextInterface
  */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <set>
@@ -303,7 +304,7 @@ void STOFFTextListener::insertUnicode(uint32_t val)
   // undef character, we skip it
   if (val == 0xfffd) return;
   if (val<0x20 && val!=0x9 && val!=0xa && val!=0xd) {
-    static int numErrors=0;
+    static std::atomic<int> numErrors(0);
     if (++numErrors<10) {
       STOFF_DEBUG_MSG(("STOFFTextListener::insertUnicode: find odd char %x\n", static_cast<unsigned int>(val)));
     }
@@ -921,7 +922,7 @@ int STOFFTextListener::_getListId() const
   if (newLevel == 0) return -1;
   int newListId = m_ps->m_paragraph.m_listId;
   if (newListId > 0) return newListId;
-  static bool first = true;
+  static std::atomic<bool> first(true);
   if (first) {
     STOFF_DEBUG_MSG(("STOFFTextListener::_getListId: the list id is not set, try to find a new one\n"));
     first = false;
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -271,7 +272,7 @@ bool Field::send(STOFFListenerPtr &listener, StarState &state) const
     field.m_propertyList.insert("librevenge:field-content", m_content);
   }
   else if (m_type==21) {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("SWFieldManagerInternal::Field::send: sending macros is not implemented\n"));
       first=false;
@@ -35,6 +35,7 @@
 #  include "config.h"
 #endif
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -48,6 +49,7 @@
 
 #include <librevenge/librevenge.h>
 
+#include "StarGraphicStruct.hxx"
 #include "StarItemPool.hxx"
 #include "StarZone.hxx"
 #include "STOFFStringStream.hxx"
@@ -72,10 +74,26 @@ struct Bitmap {
     , m_colorsList()
     , m_indexDataList()
     , m_colorDataList()
+    , m_sourceData()
+    , m_sourceUncompressedSize(0)
+    , m_sourceReadInverted(true)
+    , m_sourceColorsPos(0)
+    , m_sourcePixelsPos(0)
+    , m_memoryCharge()
   {
     m_pixelsPerMeter[0]=m_pixelsPerMeter[1]=0;
     m_numColors[0]=m_numColors[1]=0;
   }
+  //! returns the number of colors stored in the color table
+  int getNumColors() const
+  {
+    int const bitCount=m_bitCount<=1 ? 1 : m_bitCount<=4 ? 4 : m_bitCount<=8 ? 8 : 24;
+    if (bitCount > 8)
+      return 0;
+    if (m_numColors[0] > 0 && m_numColors[0] < (1u << bitCount))
+      return int(m_numColors[0]);
+    return int(1 << bitCount);
+  }
   //! try to return a ppm data (without alpha)
   bool getPPMData(librevenge::RVNGBinaryData &data) const
   {
@@ -104,8 +122,8 @@ struct Bitmap {
     }
     auto numColors=int(m_colorsList.size());
     for (auto const &index : m_indexDataList) {
-      if (index<0 || index>=numColors) {
-        STOFF_DEBUG_MSG(("StarBitmapInternal::Bitmap::getPPMData: find bad index=%d\n", index));
+      if (int(index)>=numColors) {
+        STOFF_DEBUG_MSG(("StarBitmapInternal::Bitmap::getPPMData: find bad index=%d\n", int(index)));
         return false;
       }
       uint32_t col=m_colorsList[size_t(index)].value();
@@ -114,6 +132,39 @@ struct Bitmap {
     }
     return true;
   }
+  //! try to return the colors (without alpha), row by row
+  bool getColors(std::vector<std::vector<STOFFColor> > &colors) const
+  {
+    colors.clear();
+    if (!m_width || !m_height || ((m_colorsList.empty() || m_indexDataList.empty()) && m_colorDataList.empty()))
+      return false;
+    size_t const numPixels=size_t(m_width)*size_t(m_height);
+    if ((!m_colorDataList.empty() && m_colorDataList.size()!=numPixels) ||
+        (m_colorDataList.empty() && m_indexDataList.size()!=numPixels)) {
+      STOFF_DEBUG_MSG(("StarBitmapInternal::Bitmap::getColors: data list's size is bad\n"));
+      return false;
+    }
+    auto numColors=int(m_colorsList.size());
+    colors.resize(size_t(m_height));
+    size_t p=0;
+    for (auto &row : colors) {
+      row.reserve(size_t(m_width));
+      for (uint32_t x=0; x<m_width; ++x, ++p) {
+        uint32_t col;
+        if (!m_colorDataList.empty())
+          col=m_colorDataList[p].value();
+        else if (int(m_indexDataList[p])<numColors)
+          col=m_colorsList[size_t(m_indexDataList[p])].value();
+        else {
+          STOFF_DEBUG_MSG(("StarBitmapInternal::Bitmap::getColors: find bad index=%d\n", int(m_indexDataList[p])));
+          colors.clear();
+          return false;
+        }
+        row.push_back(STOFFColor(col|0xff000000));
+      }
+    }
+    return true;
+  }
 
   //! operator<<
   friend std::ostream &operator<<(std::ostream &o, Bitmap const &info)
@@ -151,10 +202,73 @@ struct Bitmap {
   //! the bitmap color list
   std::vector<STOFFColor> m_colorsList;
   //! the index bitmap data
-  std::vector<int> m_indexDataList;
+  std::vector<uint8_t> m_indexDataList;
   //! the color bitmap data
   std::vector<STOFFColor> m_colorDataList;
+  /** the data which must be decoded to retrieve the color table and the pixels: the zlib data
+      if the bitmap is compressed, the bitmap's data if not */
+  librevenge::RVNGBinaryData m_sourceData;
+  //! the size of the uncompressed source data (or 0 if the source is not compressed)
+  uint32_t m_sourceUncompressedSize;
+  //! a flag to know if the source data are stored in little endian
+  bool m_sourceReadInverted;
+  //! the position of the color table in the (uncompressed) source data
+  long m_sourceColorsPos;
+  //! the position of the pixels in the (uncompressed) source data, 0 means after the color table
+  long m_sourcePixelsPos;
+  //! the memory charged for the index and the color data
+  libstoff::MemoryCharge m_memoryCharge;
 };
+
+#ifdef USE_ZIP
+//! try to uncompress a zlib data
+static bool uncompress(unsigned char const *data, unsigned long dataSize, uint32_t uncompressedSize, std::vector<unsigned char> &result,
+                       libstoff::MemoryCharge &resultCharge)
+{
+  int ret;
+  z_stream strm;
+
+  /* allocate inflate state */
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  strm.avail_in = 0;
+  strm.next_in = Z_NULL;
+#if defined(__clang__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#endif
+  ret = inflateInit(&strm);//,-MAX_WBITS);
+#if defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+  if (ret != Z_OK) {
+    STOFF_DEBUG_MSG(("StarBitmapInternal::uncompress: can not init stream\n"));
+    return false;
+  }
+  strm.avail_in = unsigned(dataSize);
+  strm.next_in = reinterpret_cast<Bytef *>(const_cast<unsigned char *>(data));
+
+  resultCharge.charge("StarBitmap", uncompressedSize);
+  result.resize(size_t(uncompressedSize),0);
+
+  strm.avail_out = uncompressedSize;
+  strm.next_out = reinterpret_cast<Bytef *>(&result[0]);
+  ret = inflate(&strm, Z_FINISH);
+  (void)inflateEnd(&strm);
+  switch (ret) {
+  case Z_NEED_DICT:
+  case Z_DATA_ERROR:
+  case Z_MEM_ERROR:
+    STOFF_DEBUG_MSG(("StarBitmapInternal::uncompress: can not decode stream, err=%d\n", ret));
+    return false;
+  default:
+    break;
+  }
+  return true;
+}
+#endif
+
 ////////////////////////////////////////
 //! Internal: the state of a StarBitmap
 struct State {
@@ -200,17 +314,70 @@ StarBitmap::StarBitmap(uint32_t const((&pixels)[32]), STOFFColor const((&colors)
 
 bool StarBitmap::getData(librevenge::RVNGBinaryData &data, std::string &type) const
 {
+  decodeBitmap();
   if (!m_state->m_bitmap.getPPMData(data))
     return false;
   type="image/ppm";
   return true;
 }
 
+bool StarBitmap::getBMPData(librevenge::RVNGBinaryData &data) const
+{
+  decodeBitmap();
+  std::vector<std::vector<STOFFColor> > colors;
+  return m_state->m_bitmap.getColors(colors) && StarGraphicStruct::getBMPData(colors, data);
+}
+
 STOFFVec2i StarBitmap::getBitmapSize() const
 {
   return STOFFVec2i(int(m_state->m_bitmap.m_width), int(m_state->m_bitmap.m_height));
 }
 
+bool StarBitmap::decodeBitmap() const
+{
+  auto &bitmap=m_state->m_bitmap;
+  if (bitmap.m_sourceData.empty())
+    return true;
+  librevenge::RVNGBinaryData source(bitmap.m_sourceData);
+  bitmap.m_sourceData.clear();
+  std::shared_ptr<librevenge::RVNGInputStream> stream;
+  if (bitmap.m_sourceUncompressedSize) {
+#ifdef USE_ZIP
+    std::vector<unsigned char> converted;
+    libstoff::MemoryCharge convertedCharge;
+    if (!StarBitmapInternal::uncompress(source.getDataBuffer(), source.size(), bitmap.m_sourceUncompressedSize, converted, convertedCharge))
+      return false;
+    stream.reset(new STOFFStringStream(&converted[0], unsigned(converted.size())));
+#else
+    STOFF_DEBUG_MSG(("StarBitmap::decodeBitmap: can not decode zip file\n"));
+    return false;
+#endif
+  }
+  else
+    stream.reset(new STOFFStringStream(source.getDataBuffer(), unsigned(source.size())));
+  STOFFInputStreamPtr input(new STOFFInputStream(stream, bitmap.m_sourceReadInverted));
+  long const endPos=input->size();
+  input->seek(bitmap.m_sourceColorsPos, librevenge::RVNG_SEEK_SET);
+  int const nColors=bitmap.getNumColors();
+  int const numComponent=bitmap.m_hasAlphaColor ? 4 : 3;
+  if ((endPos-input->tell())/numComponent<nColors || input->tell()+numComponent*nColors > endPos) {
+    STOFF_DEBUG_MSG(("StarBitmap::decodeBitmap: can not read the color\n"));
+    return false;
+  }
+  unsigned char col[4]= {0,0,0,255};
+  for (int i=0; i<nColors; ++i) {
+    for (int c=0; c<numComponent; ++c) col[c]=static_cast<unsigned char>(input->readULong(1));
+    bitmap.m_colorsList.push_back(STOFFColor(col[2],col[1],col[0],col[3]));
+  }
+  if (bitmap.m_sourcePixelsPos && bitmap.m_sourcePixelsPos!=input->tell())
+    input->seek(bitmap.m_sourcePixelsPos, librevenge::RVNG_SEEK_SET);
+  if (!readBitmapData(input, bitmap, endPos)) {
+    STOFF_DEBUG_MSG(("StarBitmap::decodeBitmap: can not read the bitmap\n"));
+    return false;
+  }
+  return true;
+}
+
 bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, librevenge::RVNGBinaryData &result, std::string &type)
 {
   result.clear();
@@ -259,8 +426,9 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
   pos=input->tell();
   f.str("");
   f << "StarBitmap:";
-  STOFFInputStreamPtr dInput=input;
-  long endDataPos=lastPos;
+  // only store the data, the color table and the pixels are decoded when needed
+  bitmap.m_sourceReadInverted=input->readInverted();
+  int const nColors=bitmap.getNumColors();
   if (bitmap.m_compression==0x1004453) {
     uint32_t codeSize, uncodeSize;
     *input>>codeSize>>uncodeSize>>bitmap.m_compression;
@@ -275,133 +443,72 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
       return false;
     }
     lastPos=input->tell()+long(codeSize);
-#ifdef USE_ZIP
     ascFile.skipZone(input->tell(),lastPos-1);
-    unsigned long readBytes=0;
-    uint8_t const *data=input->read(size_t(codeSize),readBytes);
-    if (!data || static_cast<uint32_t>(readBytes)!=codeSize) {
+    if (!input->readDataBlock(long(codeSize), bitmap.m_sourceData)) {
       STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read compressed data\n"));
       f << "###compressed";
-      ascFile.addPos(pos);
-      ascFile.addNote(f.str().c_str());
-      input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-      return true;
+      bitmap.m_sourceData.clear();
     }
-
-    int ret;
-    z_stream strm;
-
-    /* allocate inflate state */
-    strm.zalloc = Z_NULL;
-    strm.zfree = Z_NULL;
-    strm.opaque = Z_NULL;
-    strm.avail_in = 0;
-    strm.next_in = Z_NULL;
-#if defined(__clang__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wold-style-cast"
-#endif
-    ret = inflateInit(&strm);//,-MAX_WBITS);
-#if defined(__clang__)
-#  pragma clang diagnostic pop
-#endif
-    if (ret != Z_OK) {
-      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not init stream\n"));
-      f << "###inflateInit";
+    else {
+      bitmap.m_sourceUncompressedSize=uncodeSize;
+      bitmap.m_sourceColorsPos=bitmap.m_sourcePixelsPos=0;
+    }
+    ascFile.addPos(pos);
+    ascFile.addNote(f.str().c_str());
+    input->seek(lastPos, librevenge::RVNG_SEEK_SET);
+  }
+  else {
+    if (offset && beginPos+long(offset)>lastPos) {
+      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: the offset seems bad\n"));
+      f << "###";
       ascFile.addPos(pos);
       ascFile.addNote(f.str().c_str());
-      input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-      return true;
+      return false;
     }
-    strm.avail_in = unsigned(codeSize);
-    strm.next_in = reinterpret_cast<Bytef *>(const_cast<uint8_t *>(data));
-
-    std::vector<unsigned char> converted;
-    converted.resize(size_t(uncodeSize),0);
-
-    strm.avail_out = uncodeSize;
-    strm.next_out = reinterpret_cast<Bytef *>(&converted[0]);
-    ret = inflate(&strm, Z_FINISH);
-    switch (ret) {
-    case Z_NEED_DICT:
-    case Z_DATA_ERROR:
-    case Z_MEM_ERROR:
-      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not decode stream\n"));
-      f << "###inflateDecode,err=" << ret << ",";
+    if (offset)
+      dataPos=beginPos+offset;
+    int const numComponent=bitmap.m_hasAlphaColor ? 4 : 3;
+    if ((lastPos-input->tell())/numComponent<nColors || input->tell()+numComponent*nColors > lastPos) {
+      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the color\n"));
+      f << "###";
+      ascFile.addDelimiter(input->tell(),'|');
       ascFile.addPos(pos);
       ascFile.addNote(f.str().c_str());
       input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-      (void)inflateEnd(&strm);
       return true;
-    default:
-      break;
     }
-    (void)inflateEnd(&strm);
-    std::shared_ptr<librevenge::RVNGInputStream> newStream(new STOFFStringStream(&converted[0], unsigned(converted.size())));
-    dInput.reset(new STOFFInputStream(newStream, input->readInverted()));
-    dataPos=offset=0;
-    endDataPos=dInput->size();
-#else
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not decode zip file\n"));
-    f << "###codeSize=" << codeSize << ",";
-    ascFile.addPos(pos);
-    ascFile.addNote(f.str().c_str());
-    input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-    return true;
-#endif
-  }
-  if (offset && beginPos+long(offset)>endDataPos) {
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmap: the offset seems bad\n"));
-    f << "###";
-    ascFile.addPos(pos);
-    ascFile.addNote(f.str().c_str());
-    return false;
-  }
-  if (offset)
-    dataPos=beginPos+offset;
-  int const bitCount=bitmap.m_bitCount<=1 ? 1 : bitmap.m_bitCount<=4 ? 4 : bitmap.m_bitCount<=8 ? 8 : 24;
-  int nColors=0;
-  if (bitCount <= 8) {
-    if (bitmap.m_numColors[0] > 0 && bitmap.m_numColors[0] < (1u << bitCount))
-      nColors = int(bitmap.m_numColors[0]);
-    else
-      nColors = int(1 << bitCount);
-  }
-  int const numComponent=bitmap.m_hasAlphaColor ? 4 : 3;
-  if ((endDataPos-dInput->tell())/numComponent<nColors || dInput->tell()+numComponent*nColors > endDataPos) {
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the color\n"));
-    f << "###";
-    ascFile.addDelimiter(input->tell(),'|');
+    if (nColors) f << "num[colors]=" << nColors << ",";
     ascFile.addPos(pos);
     ascFile.addNote(f.str().c_str());
-    input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-    return true;
-  }
-  if (nColors) {
-    f << "colors=[";
-    unsigned char col[4]= {0,0,0,255};
-    for (int i=0; i<nColors; ++i) {
-      for (int c=0; c<numComponent; ++c) col[c]=static_cast<unsigned char>(dInput->readULong(1));
-      bitmap.m_colorsList.push_back(STOFFColor(col[2],col[1],col[0],col[3]));
-      f << bitmap.m_colorsList.back() << ",";
-    }
-    f << "],";
-  }
-  ascFile.addPos(pos);
-  ascFile.addNote(f.str().c_str());
 
-  pos=input->tell();
-  if (dataPos && dataPos!=dInput->tell())
-    dInput->seek(dataPos, librevenge::RVNG_SEEK_SET);
-  if (!readBitmapData(dInput, bitmap, endDataPos)) {
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the bitmap\n"));
-    ascFile.addPos(pos);
-    ascFile.addNote("StarBitmap:###unread");
-    return false;
+    long colorsPos=input->tell();
+    pos=colorsPos+numComponent*nColors;
+    if (dataPos && dataPos!=pos)
+      pos=dataPos;
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+    // look for the end of the pixels' data
+    if (!readBitmapData(input, bitmap, lastPos, true)) {
+      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the bitmap\n"));
+      ascFile.addPos(pos);
+      ascFile.addNote("StarBitmap:###unread");
+      return false;
+    }
+    long endPos=input->tell(), endSourcePos=endPos;
+    // the RLE decoder checks that the image size is available
+    if (bitmap.m_sizeImage && pos+long(bitmap.m_sizeImage)>endSourcePos && pos+long(bitmap.m_sizeImage)<=lastPos)
+      endSourcePos=pos+long(bitmap.m_sizeImage);
+    ascFile.skipZone(colorsPos,endPos-1);
+    input->seek(beginPos, librevenge::RVNG_SEEK_SET);
+    if (!input->readDataBlock(endSourcePos-beginPos, bitmap.m_sourceData)) {
+      STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not read the bitmap data\n"));
+      bitmap.m_sourceData.clear();
+    }
+    else {
+      bitmap.m_sourceColorsPos=colorsPos-beginPos;
+      bitmap.m_sourcePixelsPos=pos-beginPos;
+    }
+    input->seek(endPos, librevenge::RVNG_SEEK_SET);
   }
-  if (bitmap.m_compression!=0x1004453)
-    ascFile.skipZone(pos,input->tell()-1);
-  pos=input->tell();
 
   if (inFileHeader) {
     long actPos=input->tell();
@@ -413,7 +520,7 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
     else {
       type="image/bm";
 #if defined(DEBUG_WITH_FILES) && DEBUG_WITH_FILES
-      static int bitmapNum=0;
+      static std::atomic<int> bitmapNum(0);
       std::stringstream s;
       s << "Bitmap" << ++bitmapNum << ".bm";
       libstoff::Debug::dumpFile(result, s.str().c_str());
@@ -421,22 +528,16 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
     }
     input->seek(actPos, librevenge::RVNG_SEEK_SET);
   }
-  if (pos!=lastPos && bitmap.m_compression==0x1004453) {
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmap: find extra data\n"));
-    ascFile.addDelimiter(pos, '|');
-    ascFile.addPos(pos);
-    ascFile.addNote("StarBitmap:###extra");
-    input->seek(lastPos, librevenge::RVNG_SEEK_SET);
-  }
 #ifdef DEBUG_WITH_FILES
   if (1) {
     librevenge::RVNGBinaryData data;
-    static int bitmapNum=0;
+    static std::atomic<int> bitmapNum(0);
     std::stringstream s;
     s << "Bitmap" << ++bitmapNum << ".ppm";
 
     data.clear();
-    if (!bitmap.getPPMData(data)) {
+    std::string dataType;
+    if (!getData(data, dataType)) {
       STOFF_DEBUG_MSG(("StarBitmap::readBitmap: can not convert a bitmap\n"));
     }
     else
@@ -508,7 +609,7 @@ bool StarBitmap::readBitmapInformation(StarZone &zone, StarBitmapInternal::Bitma
   return true;
 }
 
-bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::Bitmap &bitmap, long lastPos)
+bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::Bitmap &bitmap, long lastPos, bool onlySkip) const
 {
   // bitmap2.cxx Bitmap::ImplReadDIBBits
 
@@ -553,17 +654,33 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
       STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: bitmap dimensions are too big\n"));
       return false;
     }
-    bitmap.m_indexDataList.resize(size_t(lastWPos),0);
+    if (onlySkip) // the codes are read but no index is stored
+      lastWPos=0;
+    else {
+      bitmap.m_memoryCharge.charge("StarBitmap", lastWPos);
+      bitmap.m_indexDataList.resize(size_t(lastWPos),0);
+    }
+    // read the codes in one block
+    long const rlePos=input->tell();
+    unsigned long numRead=0;
+    uint8_t const *rle=lastPos>rlePos ? input->read(size_t(lastPos-rlePos), numRead) : nullptr;
+    if (!rle || long(numRead)!=lastPos-rlePos) {
+      STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: can not read the lre data\n"));
+      return false;
+    }
+    size_t const rEnd=size_t(numRead);
+    size_t r=0;
+    uint8_t *indices=lastWPos ? &bitmap.m_indexDataList[0] : nullptr;
     uint32_t x=0, y=0;
     while (true) {
-      if (input->tell() > lastPos - 1) {
+      if (r+1 > rEnd) {
         STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: at the end of the bitmap record already\n"));
         return false;
       }
       if (y>=bitmap.m_height) break;
-      auto nCount=int(input->readULong(1));
+      auto nCount=size_t(rle[r++]);
       if (!nCount) {
-        auto nBytes=int(input->readULong(1));
+        auto nBytes=size_t(r<rEnd ? rle[r++] : 0);
         if (nBytes==0) { // new line
           ++y;
           x=0;
@@ -573,8 +690,12 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
         if (nBytes==1) // end decoding
           break;
         if (nBytes==2) {
-          x = uint32_t(x+input->readULong(1));
-          y = uint32_t(y+input->readULong(1));
+          if (r+2 > rEnd) {
+            STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: can not read a delta\n"));
+            return false;
+          }
+          x = uint32_t(x+rle[r++]);
+          y = uint32_t(y+rle[r++]);
           if (x>=bitmap.m_width) {
             STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: x seems bad\n"));
           }
@@ -585,44 +706,50 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
           wPos=size_t(y*bitmap.m_width+x);
           continue;
         }
-        int nRead=(bit4 ? (nBytes+1)/2 : nBytes);
-        if (input->tell()+nRead> lastPos) {
+        size_t nRead=(bit4 ? (nBytes+1)/2 : nBytes);
+        if (r+nRead > rEnd) {
           STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: can not read some lre count(1)\n"));
           return false;
         }
-        for (int i=0; i<nBytes; ++i) {
-          auto val=int(input->readULong(1));
-          if (bit4) {
-            if (++x<=bitmap.m_width && wPos<lastWPos) bitmap.m_indexDataList[wPos++]=(val>>4)&0xf;
-            if (++i<nBytes && ++x<=bitmap.m_width && wPos<lastWPos) bitmap.m_indexDataList[wPos++]=val&0xf;
-          }
-          else if (++x<=bitmap.m_width && wPos<lastWPos)
-            bitmap.m_indexDataList[wPos++]=val;
+        // the number of indices which can be stored in the current row
+        size_t num=x<bitmap.m_width ? size_t(bitmap.m_width-x) : 0;
+        if (num>nBytes) num=nBytes;
+        if (wPos>=lastWPos) num=0;
+        else if (num>lastWPos-wPos) num=lastWPos-wPos;
+        uint8_t const *values=rle+r;
+        if (bit4) {
+          for (size_t i=0; i<num; ++i)
+            indices[wPos+i]=uint8_t((values[i>>1]>>((i&1) ? 0 : 4))&0xf);
         }
+        else if (num)
+          std::memcpy(indices+wPos, values, num);
+        wPos+=num;
+        x=uint32_t(x+nBytes);
+        r+=nRead;
         if (nRead&1)
-          input->seek(1, librevenge::RVNG_SEEK_CUR);
+          ++r;
         continue;
       }
-      if (input->tell()+1 > lastPos) {
+      if (r+1 > rEnd) {
         STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: can not read some lre count(2)\n"));
         return false;
       }
-      auto val=int(input->readULong(1));
+      auto val=rle[r++];
+      size_t num=x<bitmap.m_width ? size_t(bitmap.m_width-x) : 0;
+      if (num>nCount) num=nCount;
+      if (wPos>=lastWPos) num=0;
+      else if (num>lastWPos-wPos) num=lastWPos-wPos;
       if (bit4) {
-        for (int i=0; i<nCount; ++i) {
-          if (++x>bitmap.m_width||wPos>=lastWPos) break;
-          bitmap.m_indexDataList[wPos++]=(val>>4)&0xf;
-          if (++i>=nCount || ++x>bitmap.m_width||wPos>=lastWPos) break;
-          bitmap.m_indexDataList[wPos++]=val&0xf;
-        }
-      }
-      else {
-        for (int i=0; i<nCount; ++i) {
-          if (++x>bitmap.m_width||wPos>=lastWPos) break;
-          bitmap.m_indexDataList[wPos++]=val;
-        }
+        uint8_t const vals[2]= {uint8_t((val>>4)&0xf), uint8_t(val&0xf)};
+        for (size_t i=0; i<num; ++i)
+          indices[wPos+i]=vals[i&1];
       }
+      else if (num)
+        std::memset(indices+wPos, val, num);
+      wPos+=num;
+      x=uint32_t(x+num);
     }
+    input->seek(rlePos+long(r), librevenge::RVNG_SEEK_SET);
     return true;
   }
   uint32_t alignWidth=bitmap.m_width*bitmap.m_bitCount;
@@ -637,86 +764,72 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
     STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: the zone seems too short\n"));
     return false;
   }
-  switch (bitmap.m_bitCount) {
-  case 1: {
-    bitmap.m_indexDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
-    size_t wPos=0;
-    for (uint32_t y=0; y<bitmap.m_height; ++y) {
-      actPos=input->tell();
-      int decal=7;
-      unsigned char val=0;
-      for (uint32_t x=0; x<bitmap.m_width; ++x) {
-        if (decal==7)
-          val=static_cast<unsigned char>(input->readULong(1));
-        bitmap.m_indexDataList[wPos++]=int((val>>decal)&1);
-        if (decal--==0)
-          decal=7;
-      }
-      input->seek(actPos+long(alignWidth), librevenge::RVNG_SEEK_SET);
-    }
-    break;
+  if (onlySkip) {
+    input->seek(actPos+long(bitmap.m_height*alignWidth), librevenge::RVNG_SEEK_SET);
+    return true;
   }
-  case 4: {
-    bitmap.m_indexDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
-    size_t wPos=0;
-    for (uint32_t y=0; y<bitmap.m_height; ++y) {
-      actPos=input->tell();
-      unsigned char val=0;
-      for (uint32_t x=0; x<bitmap.m_width; ++x) {
-        if ((x%2)==0)
-          val=static_cast<unsigned char>(input->readULong(1));
-        bitmap.m_indexDataList[wPos++]=int(((x%2) ? val : (val>>4))&0xf);
-      }
-      input->seek(actPos+long(alignWidth), librevenge::RVNG_SEEK_SET);
-    }
-    break;
+  if (bitmap.m_bitCount!=1 && bitmap.m_bitCount!=4 && bitmap.m_bitCount!=8 && bitmap.m_bitCount!=16 &&
+      bitmap.m_bitCount!=24 && bitmap.m_bitCount!=32) {
+    STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: find unexpected bit count %d\n", int(bitmap.m_bitCount)));
+    input->seek(actPos+long(bitmap.m_height*alignWidth), librevenge::RVNG_SEEK_SET);
+    return true;
   }
-  case 8: {
-    bitmap.m_indexDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
-    size_t wPos=0;
-    for (uint32_t y=0; y<bitmap.m_height; ++y) {
-      actPos=input->tell();
-      for (uint32_t x=0; x<bitmap.m_width; ++x)
-        bitmap.m_indexDataList[wPos++]=int(input->readULong(1));
-      input->seek(actPos+long(alignWidth), librevenge::RVNG_SEEK_SET);
-    }
-    break;
+  // read all the rows in one block
+  unsigned long numRead=0;
+  uint8_t const *rows=input->read(size_t(bitmap.m_height*alignWidth), numRead);
+  if (!rows || numRead!=static_cast<unsigned long>(bitmap.m_height*alignWidth)) {
+    STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: can not read the rows\n"));
+    return false;
   }
-  case 16: {
-    bitmap.m_colorDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
-    size_t wPos=0;
-    for (uint32_t y=0; y<bitmap.m_height; ++y) {
-      actPos=input->tell();
-      for (uint32_t x=0; x<bitmap.m_width; ++x) {
-        auto val=static_cast<uint16_t>(input->readULong(2));
-        bitmap.m_colorDataList[wPos++]=
-          STOFFColor(static_cast<unsigned char>((val&RGBMask[0])>>RGBShift[0]), static_cast<unsigned char>((val&RGBMask[1])>>RGBShift[1]),
-                     static_cast<unsigned char>((val&RGBMask[2])>>RGBShift[2]));
+  size_t const width=size_t(bitmap.m_width);
+  /* note: gcc -O2 does not vectorize the following loops: the rows may alias the lists, so
+     they need a runtime alias check which is only added with -O3 (for the 16/32-bit loops) */
+  if (bitmap.m_bitCount<=8) {
+    bitmap.m_memoryCharge.charge("StarBitmap", static_cast<unsigned long>(bitmap.m_height)*width);
+    bitmap.m_indexDataList.resize(size_t(bitmap.m_height)*width);
+    uint8_t *indices=&bitmap.m_indexDataList[0];
+    for (uint32_t y=0; y<bitmap.m_height; ++y, rows+=alignWidth, indices+=width) {
+      switch (bitmap.m_bitCount) {
+      case 1:
+        for (size_t x=0; x<width; ++x)
+          indices[x]=uint8_t((rows[x>>3]>>(7-(x&7)))&1);
+        break;
+      case 4:
+        for (size_t x=0; x<width; ++x)
+          indices[x]=uint8_t((rows[x>>1]>>((x&1) ? 0 : 4))&0xf);
+        break;
+      default:
+        std::memcpy(indices, rows, width);
+        break;
       }
-      input->seek(actPos+long(alignWidth), librevenge::RVNG_SEEK_SET);
     }
-    break;
+    return true;
   }
-  case 24:
-  case 32: {
-    unsigned char col[4]= {0,0,0,255};
-    int const numComponent= bitmap.m_bitCount==24 ? 3 : 4;
-    bitmap.m_colorDataList.resize(size_t(bitmap.m_height*bitmap.m_width));
-    size_t wPos=0;
-    for (uint32_t y=0; y<bitmap.m_height; ++y) {
-      actPos=input->tell();
-      for (uint32_t x=0; x<bitmap.m_width; ++x) {
-        for (int c=0; c<numComponent; ++c) col[c]=static_cast<unsigned char>(input->readULong(1));
-        bitmap.m_colorDataList[wPos++]=STOFFColor(col[0],col[1],col[2],col[3]);
+  bitmap.m_memoryCharge.charge("StarBitmap", static_cast<unsigned long>(bitmap.m_height)*width*sizeof(STOFFColor));
+  bitmap.m_colorDataList.resize(size_t(bitmap.m_height)*width);
+  STOFFColor *colors=&bitmap.m_colorDataList[0];
+  if (bitmap.m_bitCount==16) {
+    // the 16-bit values are stored in the stream order
+    int const b0=input->readInverted() ? 0 : 8, b1=input->readInverted() ? 8 : 0;
+    for (uint32_t y=0; y<bitmap.m_height; ++y, rows+=alignWidth, colors+=width) {
+      for (size_t x=0; x<width; ++x) {
+        auto val=uint32_t((rows[2*x]<<b0)|(rows[2*x+1]<<b1));
+        colors[x]=STOFFColor(static_cast<unsigned char>((val&RGBMask[0])>>RGBShift[0]), static_cast<unsigned char>((val&RGBMask[1])>>RGBShift[1]),
+                             static_cast<unsigned char>((val&RGBMask[2])>>RGBShift[2]));
       }
-      input->seek(actPos+long(alignWidth), librevenge::RVNG_SEEK_SET);
     }
-    break;
+    return true;
   }
-  default:
-    STOFF_DEBUG_MSG(("StarBitmap::readBitmapData: find unexpected bit count %d\n", int(bitmap.m_bitCount)));
-    input->seek(actPos+long(bitmap.m_height*alignWidth), librevenge::RVNG_SEEK_SET);
-    break;
+  if (bitmap.m_bitCount==24) {
+    for (uint32_t y=0; y<bitmap.m_height; ++y, rows+=alignWidth, colors+=width) {
+      for (size_t x=0; x<width; ++x)
+        colors[x]=STOFFColor(rows[3*x],rows[3*x+1],rows[3*x+2],255);
+    }
+    return true;
+  }
+  for (uint32_t y=0; y<bitmap.m_height; ++y, rows+=alignWidth, colors+=width) {
+    for (size_t x=0; x<width; ++x)
+      colors[x]=STOFFColor(rows[4*x],rows[4*x+1],rows[4*x+2],rows[4*x+3]);
   }
   return true;
 }
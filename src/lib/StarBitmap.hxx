@@ -73,17 +73,24 @@ public:
 
   /** try to read a bitmap
 
-   \note only fill data and type if the bitmap has a file header*/
+   \note only fill data and type if the bitmap has a file header. The color table and the pixels
+   are only decoded when getData is called */
   bool readBitmap(StarZone &zone, bool inFileHeader, long lastPos, librevenge::RVNGBinaryData &data, std::string &type);
   //! try to convert the read data in ppm
   bool getData(librevenge::RVNGBinaryData &data, std::string &type) const;
+  //! try to convert the read data in bmp
+  bool getBMPData(librevenge::RVNGBinaryData &data) const;
   //! try to return the bitmap size (in point)
   STOFFVec2i getBitmapSize() const;
 protected:
+  //! try to decode the color table and the pixels if this is not already done
+  bool decodeBitmap() const;
   //! try to read the bitmap information block
   bool readBitmapInformation(StarZone &zone, StarBitmapInternal::Bitmap &info, long lastPos);
-  //! try to read the bitmap data block
-  bool readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::Bitmap &bitmap, long lastPos);
+  /** try to read the bitmap data block
+
+      \note if onlySkip is set, the data are skipped without being stored */
+  bool readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::Bitmap &bitmap, long lastPos, bool onlySkip=false) const;
   //
   // data
   //
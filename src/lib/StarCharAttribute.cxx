@@ -986,7 +986,7 @@ void StarCAttributeCharFormat::addTo(StarState &state, std::set<StarAttribute co
     if (style) {
       state.m_font=STOFFFont();
       StarItemSet const &itemSet=style->m_itemSet;
-      std::map<int, std::shared_ptr<StarItem> >::const_iterator it;
+      StarItemMap::const_iterator it;
       for (it=itemSet.m_whichToItemMap.begin(); it!=itemSet.m_whichToItemMap.end(); ++it) {
         if (it->second && it->second->m_attribute)
           it->second->m_attribute->addTo(state, done);
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -169,6 +170,200 @@ StarEncoding::Encoding StarEncoding::getEncodingForId(int id)
   return res;
 }
 
+StarEncoding::Encoding StarEncoding::getEncodingForWindowsCodePage(int codePage)
+{
+  Encoding res=E_MS_1252;
+  switch (codePage) {
+  case 437:
+    res=E_IBM_437;
+    break;
+  case 737:
+    res=E_IBM_737;
+    break;
+  case 775:
+    res=E_IBM_775;
+    break;
+  case 850:
+    res=E_IBM_850;
+    break;
+  case 852:
+    res=E_IBM_852;
+    break;
+  case 855:
+    res=E_IBM_855;
+    break;
+  case 857:
+    res=E_IBM_857;
+    break;
+  case 860:
+    res=E_IBM_860;
+    break;
+  case 861:
+    res=E_IBM_861;
+    break;
+  case 862:
+    res=E_IBM_862;
+    break;
+  case 863:
+    res=E_IBM_863;
+    break;
+  case 864:
+    res=E_IBM_864;
+    break;
+  case 865:
+    res=E_IBM_865;
+    break;
+  case 866:
+    res=E_IBM_866;
+    break;
+  case 869:
+    res=E_IBM_869;
+    break;
+  case 874:
+    res=E_MS_874;
+    break;
+  case 932:
+    res=E_MS_932;
+    break;
+  case 936:
+    res=E_MS_936;
+    break;
+  case 949:
+    res=E_MS_949;
+    break;
+  case 950:
+    res=E_MS_950;
+    break;
+  case 1250:
+    res=E_MS_1250;
+    break;
+  case 1251:
+    res=E_MS_1251;
+    break;
+  case 1252:
+    res=E_MS_1252;
+    break;
+  case 1253:
+    res=E_MS_1253;
+    break;
+  case 1254:
+    res=E_MS_1254;
+    break;
+  case 1255:
+    res=E_MS_1255;
+    break;
+  case 1256:
+    res=E_MS_1256;
+    break;
+  case 1257:
+    res=E_MS_1257;
+    break;
+  case 1258:
+    res=E_MS_1258;
+    break;
+  case 1361:
+    res=E_MS_1361;
+    break;
+  case 10000:
+    res=E_APPLE_ROMAN;
+    break;
+  case 10001:
+    res=E_APPLE_JAPANESE;
+    break;
+  case 10002:
+    res=E_APPLE_CHINTRAD;
+    break;
+  case 10003:
+    res=E_APPLE_KOREAN;
+    break;
+  case 10006:
+    res=E_APPLE_GREEK;
+    break;
+  case 10007:
+    res=E_APPLE_CYRILLIC;
+    break;
+  case 10008:
+    res=E_APPLE_CHINSIMP;
+    break;
+  case 10010:
+    res=E_APPLE_ROMANIAN;
+    break;
+  case 10017:
+    res=E_APPLE_UKRAINIAN;
+    break;
+  case 10029:
+    res=E_APPLE_CENTEURO;
+    break;
+  case 10079:
+    res=E_APPLE_ICELAND;
+    break;
+  case 10081:
+    res=E_APPLE_TURKISH;
+    break;
+  case 10082:
+    res=E_APPLE_CROATIAN;
+    break;
+  case 20127:
+    res=E_ASCII_US;
+    break;
+  case 20866:
+    res=E_KOI8_R;
+    break;
+  case 20932:
+    res=E_EUC_JP;
+    break;
+  case 21866:
+    res=E_KOI8_U;
+    break;
+  case 28591:
+    res=E_ISO_8859_1;
+    break;
+  case 28592:
+    res=E_ISO_8859_2;
+    break;
+  case 28593:
+    res=E_ISO_8859_3;
+    break;
+  case 28594:
+    res=E_ISO_8859_4;
+    break;
+  case 28595:
+    res=E_ISO_8859_5;
+    break;
+  case 28596:
+    res=E_ISO_8859_6;
+    break;
+  case 28597:
+    res=E_ISO_8859_7;
+    break;
+  case 28598:
+    res=E_ISO_8859_8;
+    break;
+  case 28599:
+    res=E_ISO_8859_9;
+    break;
+  case 28603:
+    res=E_ISO_8859_13;
+    break;
+  case 28605:
+    res=E_ISO_8859_15;
+    break;
+  case 51949:
+    res=E_EUC_KR;
+    break;
+  case 65000:
+    res=E_UTF7;
+    break;
+  case 65001:
+    res=E_UTF8;
+    break;
+  default:
+    STOFF_DEBUG_MSG(("StarEncoding::getEncodingForWindowsCodePage: can not find encoding for codepage=%d\n", codePage));
+    break;
+  }
+  return res;
+}
+
 bool StarEncoding::read
 (std::vector<uint8_t> const &src, size_t &pos, StarEncoding::Encoding encoding, std::vector<uint32_t> &dest)
 {
@@ -1439,7 +1634,7 @@ bool StarEncoding::read
     break;
   }
   if (!unicode) {
-    static int numError=0;
+    static std::atomic<int> numError(0);
     if (++numError<10) {
       STOFF_DEBUG_MSG(("StarEncoding::read: unknown caracter %x\n", static_cast<unsigned int>(c)));
     }
@@ -79,6 +79,8 @@ public:
 
   //! return an encoding corresponding to an id
   static Encoding getEncodingForId(int id);
+  //! return an encoding corresponding to a Windows codepage, ie. the codepage of the property sets
+  static Encoding getEncodingForWindowsCodePage(int codePage);
   //! try to convert a list of character and transforms it a unicode's list
   static bool convert(std::vector<uint8_t> const &src, Encoding encoding, std::vector<uint32_t> &dest, std::vector<size_t> &srcPositions);
 
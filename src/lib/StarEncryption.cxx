@@ -202,6 +202,9 @@ STOFFInputStreamPtr StarEncryption::decodeStream(STOFFInputStreamPtr input, uint
     STOFF_DEBUG_MSG(("StarEncryption::decodeStream: can not read the original stream\n"));
     return res;
   }
+  // the decoded data are only kept until they are copied in the string stream
+  libstoff::MemoryCharge memoryCharge;
+  memoryCharge.charge("StarEncryption", numRead);
   std::unique_ptr<uint8_t[]> finalData{new uint8_t[numRead]};
   uint8_t *finalDataPtr=finalData.get();
   for (long l=0; l<dataSize; ++l, ++data)
@@ -550,6 +550,9 @@ bool StarFileManager::readEmbeddedPicture(std::shared_ptr<STOFFOLEParser> olePar
     STOFF_DEBUG_MSG(("StarFileManager::readEmbeddedPicture: called without OLE parser\n"));
     return false;
   }
+  // the same picture is often used many times, so decode it only once
+  if (oleParser->getEmbeddedPicture(fileName, image))
+    return true;
   auto dir=oleParser->getDirectory("EmbeddedPictures");
   if (!dir || !dir->m_input || !dir->m_input->isStructured()) {
     STOFF_DEBUG_MSG(("StarFileManager::readEmbeddedPicture: can not find the embedded picture directory\n"));
@@ -566,7 +569,9 @@ bool StarFileManager::readEmbeddedPicture(std::shared_ptr<STOFFOLEParser> olePar
   std::string type;
   if (!readEmbeddedPicture(ole,data,type,name))
     return false;
-  image.add(data, type);
+  STOFFEmbeddedObject picture(data, type);
+  oleParser->storeEmbeddedPicture(fileName, picture);
+  image.add(picture.m_dataList[0], type);
   return true;
 }
 
@@ -956,7 +961,7 @@ bool StarFileManager::readJobSetUp(StarZone &zone, bool useJobLen)
   return true;
 }
 
-bool StarFileManager::readSVGDI(StarZone &zone)
+bool StarFileManager::readSVGDI(StarZone &zone, librevenge::RVNGBinaryData *bitmapData, std::string *bitmapType)
 {
   STOFFInputStreamPtr input=zone.input();
   libstoff::DebugFile &ascFile=zone.ascii();
@@ -1205,6 +1210,10 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       std::string dataType;
       if (!bitmap.readBitmap(zone, false, endDataPos, data, dataType))
         f << "###bitmap,";
+      else if (bitmapData && bitmap.getBMPData(data) && data.size()>bitmapData->size()) {
+        *bitmapData=data;
+        if (bitmapType) *bitmapType="image/bmp";
+      }
       break;
     }
     case 19:
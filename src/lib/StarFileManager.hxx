@@ -93,8 +93,10 @@ public:
   static bool readJobSetUp(StarZone &zone, bool usePrinterLen);
   //! try to read a font
   static bool readFont(StarZone &zone);
-  //! try to read a SVGDI object
-  static bool readSVGDI(StarZone &zone);
+  /** try to read a SVGDI object
+
+      \note if bitmap is set, it is filled with the biggest bitmap of the metafile (if any), converted in BMP */
+  static bool readSVGDI(StarZone &zone, librevenge::RVNGBinaryData *bitmap=nullptr, std::string *bitmapType=nullptr);
 
 protected:
 
@@ -31,11 +31,13 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <tuple>
 
 #include <librevenge/librevenge.h>
 
@@ -311,7 +313,7 @@ bool NumberFormatter::FormatItem::updateNumberingProperties(librevenge::RVNGProp
     if (m_text.empty()) break;
     auto fChar=int(m_text.cstr()[0]);
     if (fChar>=32) {
-      static int cCharWidths[ 128-32 ] = {
+      static int const cCharWidths[ 128-32 ] = {
         1,1,1,2,2,3,2,1,1,1,1,2,1,1,1,1,
         2,2,2,2,2,2,2,2,2,2,1,1,2,2,2,2,
         3,2,2,2,2,2,2,3,2,1,2,2,2,3,3,3,
@@ -548,6 +550,24 @@ bool NumberFormatter::Format::updateNumberingProperties(STOFFCell &cell, std::st
   return done;
 }
 
+////////////////////////////////////////
+//! Internal: the key of the numbering cache: the format id, the cell's format type and number type
+typedef std::tuple<unsigned, int, int> NumberingKey;
+
+//! Internal: the format and the numbering properties of a cell computed by updateNumberingProperties
+struct NumberingProperties {
+  //! constructor
+  NumberingProperties(STOFFCell::Format const &format, librevenge::RVNGPropertyList const &propList)
+    : m_format(format)
+    , m_propList(propList)
+  {
+  }
+  //! the cell's format
+  STOFFCell::Format m_format;
+  //! the numbering properties
+  librevenge::RVNGPropertyList m_propList;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a StarFormatManager
 struct State {
@@ -555,12 +575,15 @@ struct State {
   State()
     : m_idNumberFormatMap()
     , m_nameToFormatDefMap()
+    , m_numberingCache()
   {
   }
   //! a map id to number format
   std::map<unsigned, NumberFormatter> m_idNumberFormatMap;
   //! a map name to format definition
   std::map<librevenge::RVNGString, std::shared_ptr<StarFormatManagerInternal::FormatDef> > m_nameToFormatDefMap;
+  //! the numbering properties already computed
+  std::map<NumberingKey, NumberingProperties> m_numberingCache;
 };
 }
 
@@ -967,7 +990,7 @@ bool StarFormatManager::readNumberFormatter(StarZone &zone)
       m_state->m_idNumberFormatMap[unsigned(id)]=form;
     else if (ok) {
       // FIXME: can happen in StarChartDocument which can have multible number formatter zones
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarFormatManager::readNumberFormatter: format %d already exist...\n", int(id)));
         first=false;
@@ -993,7 +1016,7 @@ bool StarFormatManager::readNumberFormatter(StarZone &zone)
 
     if (input->tell()!=endFieldPos) {
       // now there can still be a list of currency version....
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarFormatManager::readSWNumberFormat: find extra data\n"));
         first=false;
@@ -1147,6 +1170,35 @@ bool StarFormatManager::readSWPatternLCL(StarZone &zone)
 }
 
 void StarFormatManager::updateNumberingProperties(STOFFCell &cell) const
+{
+  auto const &format=cell.getFormat();
+  StarFormatManagerInternal::NumberingKey key(cell.getCellStyle().m_format, int(format.m_format), int(format.m_numberFormat));
+  auto it=m_state->m_numberingCache.find(key);
+  if (it==m_state->m_numberingCache.end()) {
+    // the result only depends on the format id and on the cell's format, so compute it with an empty numbering style
+    STOFFCell tmpCell;
+    tmpCell.setFormat(format);
+    tmpCell.getCellStyle().m_format=cell.getCellStyle().m_format;
+    computeNumberingProperties(tmpCell);
+    it=m_state->m_numberingCache.insert
+       (std::make_pair(key, StarFormatManagerInternal::NumberingProperties(tmpCell.getFormat(), tmpCell.getNumberingStyle()))).first;
+  }
+  cell.setFormat(it->second.m_format);
+  auto &propList=cell.getNumberingStyle();
+  if (propList.empty()) {
+    propList=it->second.m_propList;
+    return;
+  }
+  librevenge::RVNGPropertyList::Iter i(it->second.m_propList);
+  for (i.rewind(); i.next();) {
+    if (i.child())
+      propList.insert(i.key(), *i.child());
+    else if (i())
+      propList.insert(i.key(), i()->clone());
+  }
+}
+
+void StarFormatManager::computeNumberingProperties(STOFFCell &cell) const
 {
   auto const &style=cell.getCellStyle();
   auto &propList=cell.getNumberingStyle();
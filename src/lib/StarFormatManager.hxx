@@ -113,13 +113,19 @@ public:
   //! try to read number formatter type
   bool readNumberFormatter(StarZone &zone);
 
-  //! try to update the cell's data
+  /** try to update the cell's data
+
+      \note the computed format and numbering properties are stored in a cache, so they
+      are computed only once for each format id and each cell's original format; a call
+      still copies the cached property list, so it costs about half of the computation */
   void updateNumberingProperties(STOFFCell &cell) const;
 
   //
   // data
   //
 private:
+  //! computes the cell's format and numbering properties
+  void computeNumberingProperties(STOFFCell &cell) const;
   //! the state
   std::shared_ptr<StarFormatManagerInternal::State> m_state;
 };
@@ -778,9 +778,10 @@ void StarFAttributeBrush::addTo(StarState &state, std::set<StarAttribute const *
       else {
         STOFFEmbeddedObject object;
         STOFFVec2i size;
-        if (m_brush.getPattern(object, size) && object.m_dataList.size()) {
+        librevenge::RVNGString base64Data;
+        if (state.m_global->m_object.getBrushPattern(m_brush, object, size, base64Data)) {
           state.m_graphic.m_propertyList.insert("draw:fill", "bitmap");
-          state.m_graphic.m_propertyList.insert("draw:fill-image", object.m_dataList[0].getBase64Data());
+          state.m_graphic.m_propertyList.insert("draw:fill-image", base64Data);
           state.m_graphic.m_propertyList.insert("draw:fill-image-width", size[0], librevenge::RVNG_POINT);
           state.m_graphic.m_propertyList.insert("draw:fill-image-height", size[1], librevenge::RVNG_POINT);
           state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point-x",0, librevenge::RVNG_POINT);
@@ -835,9 +836,10 @@ void StarFAttributeBrush::addTo(StarState &state, std::set<StarAttribute const *
     }
     STOFFEmbeddedObject object;
     STOFFVec2i size;
-    if (m_brush.getPattern(object, size) && object.m_dataList.size()) {
+    librevenge::RVNGString base64Data;
+    if (state.m_global->m_object.getBrushPattern(m_brush, object, size, base64Data)) {
       librevenge::RVNGPropertyList backgroundList;
-      backgroundList.insert("librevenge:bitmap", object.m_dataList[0].getBase64Data());
+      backgroundList.insert("librevenge:bitmap", base64Data);
       backgroundList.insert("xlink:type", "simple");
       backgroundList.insert("xlink:show", "embed");
       backgroundList.insert("xlink:actuate", "onLoad");
@@ -32,6 +32,7 @@
 */
 
 #include <math.h>
+#include <atomic>
 #include <sstream>
 
 #include <librevenge/librevenge.h>
@@ -122,7 +123,7 @@ static std::unique_ptr<unsigned char[]> createAndInitBMPData(STOFFVec2i const &s
 }
 
 //! Internal: helper function to create a BMP for a color bitmap (freely inspired from libpwg::WPGBitmap.cpp)
-inline bool getBMPData(std::vector<std::vector<STOFFColor> > const &orig, librevenge::RVNGBinaryData &data)
+bool getBMPData(std::vector<std::vector<STOFFColor> > const &orig, librevenge::RVNGBinaryData &data)
 {
   if (orig.empty() || orig[0].empty()) return false;
   STOFFVec2i sz(int(orig[0].size()),int(orig.size()));
@@ -192,7 +193,7 @@ static double getInchValue(librevenge::RVNGProperty const *prop)
   case librevenge::RVNG_PERCENT:
   case librevenge::RVNG_UNIT_ERROR:
   default: {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarGraphicStruct::getInchValue: call with no double value\n"));
       first=false;
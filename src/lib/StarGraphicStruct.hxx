@@ -47,6 +47,9 @@ class StarZone;
 //! a name use to define basic StarOffice graphic structure
 namespace StarGraphicStruct
 {
+//! try to create a 32 bits BMP file from a table of colors (the first row is the top row)
+bool getBMPData(std::vector<std::vector<STOFFColor> > const &orig, librevenge::RVNGBinaryData &data);
+
 //! Class to store a brush
 class StarBrush
 {
@@ -38,7 +38,9 @@
 #ifndef STAR_ITEM_HXX
 #  define STAR_ITEM_HXX
 
-#include <map>
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <libstaroffice/STOFFDocument.hxx>
@@ -82,6 +84,90 @@ private:
   StarItem &operator=(StarItem const &);
 };
 
+/** \brief a small map which id to item
+
+    \note an item set contains generally few items and is mainly
+    iterated, so the items are stored in a vector sorted by which id.
+ */
+class StarItemMap
+{
+public:
+  //! the value type
+  typedef std::pair<int, std::shared_ptr<StarItem> > value_type;
+  //! the iterator
+  typedef std::vector<value_type>::iterator iterator;
+  //! the const iterator
+  typedef std::vector<value_type>::const_iterator const_iterator;
+  //! constructor
+  StarItemMap()
+    : m_values()
+  {
+  }
+  //! return true if the map is empty
+  bool empty() const
+  {
+    return m_values.empty();
+  }
+  //! return the number of items
+  size_t size() const
+  {
+    return m_values.size();
+  }
+  //! remove all items
+  void clear()
+  {
+    m_values.clear();
+  }
+  //! return the first position
+  iterator begin()
+  {
+    return m_values.begin();
+  }
+  //! return the first position
+  const_iterator begin() const
+  {
+    return m_values.begin();
+  }
+  //! return the end position
+  iterator end()
+  {
+    return m_values.end();
+  }
+  //! return the end position
+  const_iterator end() const
+  {
+    return m_values.end();
+  }
+  //! try to find the item corresponding to a which id
+  iterator find(int which)
+  {
+    auto it=std::lower_bound(m_values.begin(), m_values.end(), which, compare);
+    return (it!=m_values.end() && it->first==which) ? it : m_values.end();
+  }
+  //! try to find the item corresponding to a which id
+  const_iterator find(int which) const
+  {
+    auto it=std::lower_bound(m_values.begin(), m_values.end(), which, compare);
+    return (it!=m_values.end() && it->first==which) ? it : m_values.end();
+  }
+  //! return the item corresponding to a which id, creates it if needed
+  std::shared_ptr<StarItem> &operator[](int which)
+  {
+    auto it=std::lower_bound(m_values.begin(), m_values.end(), which, compare);
+    if (it!=m_values.end() && it->first==which)
+      return it->second;
+    return m_values.insert(it, value_type(which, std::shared_ptr<StarItem>()))->second;
+  }
+protected:
+  //! compares a value with a which id
+  static bool compare(value_type const &value, int which)
+  {
+    return value.first<which;
+  }
+  //! the list of items sorted by which id
+  std::vector<value_type> m_values;
+};
+
 /** \brief class to store a list of item
  */
 class StarItemSet
@@ -108,7 +194,7 @@ public:
   //! the family
   int m_family;
   //! the list of item
-  std::map<int, std::shared_ptr<StarItem> > m_whichToItemMap;
+  StarItemMap m_whichToItemMap;
 };
 
 //! brief class used to stored the style
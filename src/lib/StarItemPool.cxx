@@ -32,6 +32,7 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -956,7 +957,7 @@ StarItemPool::Type StarItemPool::getType() const
 
 std::shared_ptr<StarItem> StarItemPool::createItem(int which, int surrogateId, bool localId)
 {
-  std::shared_ptr<StarItem> res(new StarItem(which));
+  auto res=std::make_shared<StarItem>(which);
   res->m_surrogateId=surrogateId;
   res->m_localId=localId;
   m_state->m_delayedItemList.push_back(res);
@@ -1081,7 +1082,7 @@ std::shared_ptr<StarItem> StarItemPool::readItem(StarZone &zone, bool isDirect,
       STOFF_DEBUG_MSG(("StarItemPool::readItem: find bad position\n"));
     }
     else if (ok)
-      pItem.reset(new StarItem(StarAttributeManager::getDummyAttribute(), nWhich));
+      pItem=std::make_shared<StarItem>(StarAttributeManager::getDummyAttribute(), nWhich);
     ascii.addPos(pos);
     ascii.addNote(f.str().c_str());
     return pItem;
@@ -1092,7 +1093,7 @@ std::shared_ptr<StarItem> StarItemPool::readItem(StarZone &zone, bool isDirect,
       pItem=loadSurrogate(zone, nWhich, true, f);
     else {
       input->seek(2, librevenge::RVNG_SEEK_CUR);
-      pItem.reset(new StarItem(StarAttributeManager::getDummyAttribute(), nWhich));
+      pItem=std::make_shared<StarItem>(StarAttributeManager::getDummyAttribute(), nWhich);
     }
   }
   if (isDirect || (nWhich && !pItem)) {
@@ -1107,7 +1108,7 @@ std::shared_ptr<StarItem> StarItemPool::readItem(StarZone &zone, bool isDirect,
     else if (nLength) {
       long endAttrPos=input->tell()+long(nLength);
       auto attribute=readAttribute(zone, int(nWhich), int(nVersion), endAttrPos);
-      pItem.reset(new StarItem(attribute, nWhich));
+      pItem=std::make_shared<StarItem>(attribute, nWhich);
       if (!attribute) {
         STOFF_DEBUG_MSG(("StarItemPool::readItem: can not read an attribute\n"));
         f << "###";
@@ -1177,7 +1178,7 @@ std::shared_ptr<StarItem> StarItemPool::loadSurrogate(StarZone &zone, uint16_t &
   }
   if (m_state->m_loadingVersion<0) // the pool is not read, so we wait
     return createItem(int(nWhich), int(nSurrog), localId);
-  std::shared_ptr<StarItem> res(new StarItem(int(nWhich)));
+  auto res=std::make_shared<StarItem>(int(nWhich));
   int aWhich=(localId && m_state->m_currentVersion!=m_state->m_loadingVersion) ?
              m_state->getWhich(nWhich) : nWhich;
   StarItemPoolInternal::Values *values=m_state->getValues(aWhich);
@@ -2043,7 +2044,7 @@ bool StarItemPool::readStyles(StarZone &zone, StarObject &doc)
     }
     else if (nSize) {
       f << "#size=" << nSize << ",";
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarItemPool::readStyles: loading the base sheet data is not implemented\n"));
         first=false;
@@ -2070,7 +2071,7 @@ void StarItemPool::updateStyles()
 {
   std::set<StarItemPoolInternal::StyleId> done, toDo;
   std::multimap<StarItemPoolInternal::StyleId, StarItemPoolInternal::StyleId> childMap;
-  std::map<int, std::shared_ptr<StarItem> >::const_iterator iIt;
+  StarItemMap::const_iterator iIt;
   for (auto it : m_state->m_styleIdToStyleMap) {
     if (it.second.m_names[1].empty())
       toDo.insert(it.first);
@@ -467,7 +467,7 @@ protected:
   std::map<int,IdIsoLanguageEntry> m_idLanguageMap;
 };
 
-static IdIsoLanguageMap s_idLanguageMap;
+static IdIsoLanguageMap const s_idLanguageMap;
 bool getLanguageId(int id, std::string &lang, std::string &country)
 {
   return s_idLanguageMap.getLanguageId(id, lang, country);
@@ -31,16 +31,19 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <tuple>
 
 #include <librevenge/librevenge.h>
 
 #include "StarAttribute.hxx"
 #include "StarFileManager.hxx"
+#include "StarGraphicStruct.hxx"
 #include "StarItemPool.hxx"
 #include "StarZone.hxx"
 #include "StarFormatManager.hxx"
@@ -57,6 +60,7 @@ struct State {
     : m_poolList()
     , m_attributeManager(new StarAttributeManager)
     , m_formatManager(new StarFormatManager)
+    , m_brushPatternMap()
   {
   }
   //! copy constructor
@@ -69,6 +73,8 @@ struct State {
   std::shared_ptr<StarFormatManager> m_formatManager;
   //! the list of user name
   librevenge::RVNGString m_userMetaNames[4];
+  //! a map (style, fill color, color) to brush pattern and its base64 encoding
+  std::map<std::tuple<int, uint32_t, uint32_t>, std::pair<STOFFEmbeddedObject, librevenge::RVNGString> > m_brushPatternMap;
 private:
   State operator=(State const &) = delete;
 };
@@ -103,6 +109,28 @@ StarObject::~StarObject()
 {
 }
 
+bool StarObject::getBrushPattern(StarGraphicStruct::StarBrush const &brush, STOFFEmbeddedObject &object, STOFFVec2i &sz,
+                                 librevenge::RVNGString &base64Data)
+{
+  auto key=std::make_tuple(brush.m_style, brush.m_fillColor.value(), brush.m_color.value());
+  auto it=m_state->m_brushPatternMap.find(key);
+  if (it!=m_state->m_brushPatternMap.end()) {
+    object=it->second.first;
+    base64Data=it->second.second;
+    sz=STOFFVec2i(8,8);
+    return !object.isEmpty();
+  }
+  bool ok=brush.getPattern(object, sz) && !object.m_dataList.empty();
+  if (ok)
+    base64Data=object.m_dataList[0].getBase64Data();
+  else {
+    object=STOFFEmbeddedObject();
+    base64Data.clear();
+  }
+  m_state->m_brushPatternMap[key]=std::make_pair(object, base64Data);
+  return ok;
+}
+
 void StarObject::cleanPools()
 {
   for (auto &p : m_state->m_poolList) {
@@ -226,6 +254,67 @@ bool StarObject::parse()
   return true;
 }
 
+bool StarObject::readMetaData(STOFFInputStreamPtr file, librevenge::RVNGPropertyList &metaData)
+{
+  metaData.clear();
+  if (!file || !file->isStructured()) {
+    STOFF_DEBUG_MSG(("StarObject::readMetaData: called without structured input\n"));
+    return false;
+  }
+  bool ok=false;
+  auto ole=file->getSubStreamByName("SfxDocumentInfo");
+  if (ole) {
+    std::shared_ptr<STOFFOLEParser> oleParser;
+    std::shared_ptr<STOFFOLEParser::OleDirectory> directory;
+    StarObject object(nullptr, oleParser, directory);
+    ole->setReadInverted(true);
+    object.readSfxDocumentInformation(ole, "SfxDocumentInfo");
+    metaData=object.getMetaData();
+    ok=true;
+  }
+  // the summary information can contain similar data, do not erase the SfxDocumentInfo's data
+  librevenge::RVNGPropertyList summaryData;
+  if (STOFFOLEParser::getSummaryInformation(file, summaryData)) {
+    ok=true;
+    librevenge::RVNGPropertyList::Iter i(summaryData);
+    for (i.rewind(); i.next();) {
+      if (!metaData[i.key()])
+        metaData.insert(i.key(), i()->clone());
+    }
+  }
+  return ok;
+}
+
+bool StarObject::readThumbnail(STOFFInputStreamPtr file, librevenge::RVNGBinaryData &data, std::string &type)
+{
+  data.clear();
+  type="";
+  if (!file || !file->isStructured()) {
+    STOFF_DEBUG_MSG(("StarObject::readThumbnail: called without structured input\n"));
+    return false;
+  }
+  auto input=file->getSubStreamByName("SfxPreview");
+  if (!input || input->size()<=0) return false;
+  input->setReadInverted(true);
+  StarZone zone(input, "SfxPreview", "SfxPreview", nullptr);
+  zone.ascii().open("SfxPreview");
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  if (!StarFileManager::readSVGDI(zone, &data, &type)) {
+    STOFF_DEBUG_MSG(("StarObject::readThumbnail: can not read the metafile\n"));
+    data.clear();
+    return false;
+  }
+  if (!data.empty()) return true;
+  // no bitmap, returns the metafile
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  unsigned long numRead;
+  auto const *buffer=input->read(static_cast<unsigned long>(input->size()), numRead);
+  if (!buffer || numRead!=static_cast<unsigned long>(input->size())) return false;
+  data.append(buffer, numRead);
+  type="image/x-svm";
+  return true;
+}
+
 bool StarObject::readItemSet(StarZone &zone, std::vector<STOFFVec2i> const &/*limits*/, long lastPos,
                              StarItemSet &itemSet, StarItemPool *pool, bool isDirect)
 {
@@ -252,7 +341,7 @@ bool StarObject::readItemSet(StarZone &zone, std::vector<STOFFVec2i> const &/*li
     if (n) {
       if (lastPos!=pos+2+6*n) {
         // TODO poolio.cxx SfxItemPool::LoadItem
-        static bool first=true;
+        static std::atomic<bool> first(true);
         if (first) {
           STOFF_DEBUG_MSG(("StarObject::readItemSet: reading a SfxItem is not implemented without pool\n"));
           first=false;
@@ -55,6 +55,10 @@ struct State;
 class StarAttributeManager;
 class StarFormatManager;
 class StarItemSet;
+namespace StarGraphicStruct
+{
+class StarBrush;
+}
 
 /** \brief an object corresponding to an OLE directory
  *
@@ -98,6 +102,21 @@ public:
   }
   //! returns the ith user meta data
   librevenge::RVNGString getUserNameMetaData(int i) const;
+  /** try to return the pattern corresponding to a brush and the base64 encoding of its first data.
+
+      \note the patterns are cached by style and colors, so the brushes with the same pattern share the same binary data
+      and the pattern is only encoded once */
+  bool getBrushPattern(StarGraphicStruct::StarBrush const &brush, STOFFEmbeddedObject &object, STOFFVec2i &sz,
+                       librevenge::RVNGString &base64Data);
+  /** try to read only the meta data of a file: "SfxDocumentInfo" and "SummaryInformation"
+
+      \note the main document's zones are not read */
+  static bool readMetaData(STOFFInputStreamPtr fileInput, librevenge::RVNGPropertyList &metaData);
+  /** try to retrieve the preview stored in the "SfxPreview" zone of a file.
+
+      \note if the metafile contains a bitmap, returns the biggest bitmap; if not,
+      returns the original StarView metafile with "image/x-svm" as type */
+  static bool readThumbnail(STOFFInputStreamPtr fileInput, librevenge::RVNGBinaryData &data, std::string &type);
   // the document pool
   //! clean each pool
   void cleanPools();
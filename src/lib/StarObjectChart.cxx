@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -517,7 +518,7 @@ bool StarObjectChart::readSCHAttributes(StarZone &zone)
   auto pool=findItemPool(StarItemPool::T_XOutdevPool, false);
   if (!pool) {
     // CHANGEME
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarObjectChart::readSCHAttributes: can not read a pool, create a false one\n"));
       first=false;
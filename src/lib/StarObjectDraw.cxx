@@ -64,12 +64,18 @@ struct State {
   State()
     : m_model()
     , m_numPages()
+    , m_firstPage(0)
+    , m_lastPage(0)
   {
   }
   //! the model
   std::shared_ptr<StarObjectModel> m_model;
   //! the list of pages number
   int m_numPages;
+  //! the first page to send: 1 means the first page, 0 means no limit
+  int m_firstPage;
+  //! the last page to send: 0 means no limit
+  int m_lastPage;
 };
 
 }
@@ -94,17 +100,30 @@ StarObjectDraw::~StarObjectDraw()
 //
 ////////////////////////////////////////////////////////////
 
+void StarObjectDraw::setPageRange(int firstPage, int lastPage)
+{
+  m_drawState->m_firstPage=firstPage;
+  m_drawState->m_lastPage=lastPage;
+}
+
 bool StarObjectDraw::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages) const
 {
   if (!m_drawState->m_model)
     return false;
 
+  m_drawState->m_model->setPageRange(m_drawState->m_firstPage, m_drawState->m_lastPage);
+
   if (!m_drawState->m_model->updatePageSpans(pageSpan, numPages))
     return false;
   m_drawState->m_numPages=numPages;
   return numPages>0;
 }
 
+int StarObjectDraw::getNumPages() const
+{
+  return m_drawState->m_model ? m_drawState->m_model->getNumPages() : 0;
+}
+
 bool StarObjectDraw::sendMasterPages(STOFFGraphicListenerPtr listener)
 {
   if (!m_drawState->m_model)
@@ -67,9 +67,13 @@ public:
   ~StarObjectDraw() override;
   //! try to parse the current object
   bool parse();
+  //! defines the range of pages to send: 1 means the first page, 0 means no limit
+  void setPageRange(int firstPage, int lastPage);
 
   /** try to update the page span (to create draw document)*/
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages) const;
+  //! returns the number of pages of the document (including the pages which are not in the range)
+  int getNumPages() const;
   //! try to send the different page
   bool sendPages(STOFFGraphicListenerPtr listener);
   //! try to send the master pages
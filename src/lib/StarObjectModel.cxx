@@ -263,6 +263,7 @@ struct State {
     , m_masterPageToSendSet()
     , m_idToObjectMap()
   {
+    for (auto &p : m_pageRange) p=0;
   }
   //! small operator<< to print the content of the state
   friend std::ostream &operator<<(std::ostream &o, State const &state)
@@ -330,7 +331,8 @@ struct State {
   std::set<int> m_masterPageToSendSet;
   //! a map objectId to object
   std::map<int, std::shared_ptr<StarObjectSmallGraphic> > m_idToObjectMap;
-
+  //! the first and the last page to send (1 means the first page, 0 means no limit)
+  int m_pageRange[2];
 };
 
 }
@@ -357,6 +359,15 @@ std::ostream &operator<<(std::ostream &o, StarObjectModel const &model)
 ////////////////////////////////////////////////////////////
 // send data
 ////////////////////////////////////////////////////////////
+void StarObjectModel::setPageRange(int firstPage, int lastPage)
+{
+  if (lastPage>0 && firstPage>lastPage) {
+    STOFF_DEBUG_MSG(("StarObjectModel::setPageRange: the page range %d-%d seems bad\n", firstPage, lastPage));
+  }
+  m_modelState->m_pageRange[0]=firstPage>0 ? firstPage : 0;
+  m_modelState->m_pageRange[1]=lastPage>0 ? lastPage : 0;
+}
+
 bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &number, bool usePage0) const
 {
   m_modelState->m_pageToSendList.clear();
@@ -374,12 +385,18 @@ bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int
     return true;
   }
   auto numMasterPage=int(m_modelState->m_masterPageList.size());
+  int const *range=m_modelState->m_pageRange;
+  int pageNumber=0;
   for (size_t i=0; i<m_modelState->m_pageList.size(); ++i) {
     if (!m_modelState->m_pageList[i])
       continue;
     auto const &page=*m_modelState->m_pageList[i];
     int id=page.getMasterPageId();
     if (id<=0 || (id&1)!=1) continue;
+    ++pageNumber;
+    // only the selected pages and their master pages are sent
+    if (range[0]>0 && pageNumber<range[0]) continue;
+    if (range[1]>0 && pageNumber>range[1]) break;
     m_modelState->m_pageToSendList.push_back(int(i));
     STOFFPageSpan ps;
     page.updatePageSpan(ps, relUnit);
@@ -395,6 +412,17 @@ bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int
   return number!=0;
 }
 
+int StarObjectModel::getNumPages() const
+{
+  int numPages=0;
+  for (auto const &page : m_modelState->m_pageList) {
+    if (!page) continue;
+    int id=page->getMasterPageId();
+    if (id>0 && (id&1)==1) ++numPages;
+  }
+  return numPages;
+}
+
 void StarObjectModel::updateObjectIds(std::set<long> &unusedId)
 {
   if (m_modelState->m_pageList.empty() || !m_modelState->m_pageList[0])
@@ -75,8 +75,14 @@ public:
       \note this is used to retrieve an object in a .sdw's DrawingLawer stream
    */
   void updateObjectIds(std::set<long> &unusedId);
+  /** defines the range of pages to send: 1 means the first page, 0 means no limit.
+
+      \note the master pages which are not used by a page of the range are not sent */
+  void setPageRange(int firstPage, int lastPage);
   /** try to update the page span (to create draw document)*/
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages, bool usePage0=false) const;
+  //! returns the number of pages of a drawing, ie. the number of pages sent if no range is defined
+  int getNumPages() const;
   //! try to send the master pages
   bool sendMasterPages(STOFFGraphicListenerPtr listener);
   //! try to send the different page
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -265,7 +266,7 @@ public:
   //! try to send the graphic to the listener
   virtual bool send(STOFFListenerPtr &/*listener*/, STOFFFrameStyle const &/*pos*/, StarObject &/*object*/, bool /*inMasterPage*/)
   {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       first=false;
       STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::Graphic::send: not implemented for identifier %d\n", m_identifier));
@@ -971,7 +972,7 @@ public:
       return false;
     }
     if ((!m_graphic || m_graphic->m_object.isEmpty()) && m_graphNames[1].empty()) {
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         first=false;
         STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::SdrGraphicGraph::send: sorry, can not find some graphic representation\n"));
@@ -1320,7 +1321,7 @@ bool SdrGraphicPath::send(STOFFListenerPtr &listener, STOFFFrameStyle const &pos
   case 2: // line
     if (m_pathPolygons.size()==2) {
       // version <6 : two poly, one for each arrow?
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::SdrGraphicPath::send: find a line defined by two polygons, unsure\n"));
         first=false;
@@ -1502,7 +1503,7 @@ public:
   {
     if (m_identifier && m_group)
       return m_group->send(listener, pos, object, inMasterPage);
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       first=false;
       STOFF_DEBUG_MSG(("StarObjectSmallGraphicInternal::SCHUGraphic::send: not implemented for identifier %d\n", m_identifier));
@@ -1728,7 +1729,7 @@ bool StarObjectSmallGraphic::send(STOFFListenerPtr &listener, STOFFFrameStyle co
     return false;
   }
   if (!m_graphicState->m_graphic) {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       first=false;
       STOFF_DEBUG_MSG(("StarObjectSmallGraphic::send: no object\n"));
@@ -1803,7 +1804,7 @@ bool StarObjectSmallGraphic::readSdrObject(StarZone &zone)
     }
     f.str("");
     f << "SVDR:##extra";
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSdrObject: read object, find extra data\n"));
       first=false;
@@ -1970,7 +1971,7 @@ std::shared_ptr<StarObjectSmallGraphicInternal::SdrGraphic> StarObjectSmallGraph
   if (input->tell()==endPos)
     return graphic;
   graphic.reset(new StarObjectSmallGraphicInternal::SdrGraphic(identifier));
-  static bool first=true;
+  static std::atomic<bool> first(true);
   if (first) {
     STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSVDRObject: find unexpected data\n"));
   }
@@ -3283,7 +3284,7 @@ std::shared_ptr<StarObjectSmallGraphicInternal::SDRUserData> StarObjectSmallGrap
     else {
       STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSDRUserData: find unknown type=%s\n", type.c_str()));
       f << "###";
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         first=false;
         STOFF_DEBUG_MSG(("StarObjectSmallGraphic::readSDRUserData: reading data is not implemented\n"));
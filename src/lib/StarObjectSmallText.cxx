@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -167,7 +168,7 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
           editState.m_field.reset();
         }
       }
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first && (editState.m_content || editState.m_flyCnt || editState.m_footnote || !editState.m_link.empty() || !editState.m_refMark.empty())) {
         STOFF_DEBUG_MSG(("StarObjectSmallTextInternal::Paragraph::send: sorry, sending content/field/flyCnt/footnote/refMark/link is not implemented\n"));
         first=false;
@@ -245,6 +246,17 @@ bool StarObjectSmallText::send(std::shared_ptr<STOFFListener> listener, int leve
   return true;
 }
 
+void StarObjectSmallText::getText(std::vector<uint32_t> &text) const
+{
+  text.clear();
+  for (size_t p=0; p<m_textState->m_paragraphList.size(); ++p) {
+    auto const &para=m_textState->m_paragraphList[p];
+    text.insert(text.end(), para.m_text.begin(), para.m_text.end());
+    if (p+1!=m_textState->m_paragraphList.size())
+      text.push_back(0xa);
+  }
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -68,6 +68,8 @@ public:
 
   //! try to send a small text zone
   bool send(std::shared_ptr<STOFFListener> listener, int level=-1);
+  //! returns the text content, the paragraphs being separated by a line feed
+  void getText(std::vector<uint32_t> &text) const;
 protected:
   //
   // low level
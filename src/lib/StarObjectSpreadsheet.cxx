@@ -31,10 +31,13 @@
 * instead of those above.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <set>
 #include <sstream>
 
@@ -273,6 +276,7 @@ public:
     , m_content()
     , m_textZone()
     , m_hasNote(false)
+    , m_memoryCharge()
   {
     setPosition(pos);
   }
@@ -286,6 +290,8 @@ public:
   bool m_hasNote;
   //! the notes text, date, author
   librevenge::RVNGString m_notes[3];
+  //! the memory charged for the cell
+  libstoff::MemoryCharge m_memoryCharge;
 };
 
 Cell::~Cell()
@@ -346,6 +352,8 @@ public:
     , m_colWidthList()
     , m_rowHeightMap()
     , m_rowToRowContentMap()
+    , m_position(0)
+    , m_columnToDataPositionsMap()
     , m_badCell()
   {
   }
@@ -455,6 +463,7 @@ public:
     RowContent *row=getRow(pos[1]);
     if (row->m_colToCellMap.find(pos[0]) == row->m_colToCellMap.end() || !row->m_colToCellMap.find(pos[0])->second) {
       std::shared_ptr<Cell> newCell(new Cell(pos));
+      newCell->m_memoryCharge.charge("SpreadsheetCell", sizeof(Cell));
       row->m_colToCellMap.insert(std::map<int, std::shared_ptr<Cell> >::value_type(pos[0],newCell));
       return *newCell;
     }
@@ -475,6 +484,10 @@ public:
   std::map<STOFFVec2i, int> m_rowHeightMap;
   //! map (min row, max row) -> rowContent
   std::map<STOFFVec2i, RowContent> m_rowToRowContentMap;
+  //! the table position in the StarCalcDocument zone
+  long m_position;
+  //! map column -> list of SCData positions
+  std::map<int, std::vector<long> > m_columnToDataPositionsMap;
   //! a cell uses to return an empty cell
   Cell m_badCell;
 };
@@ -492,6 +505,9 @@ struct State {
     , m_tableList()
     , m_sheetNames()
     , m_pageStyle("")
+    , m_calcDocumentName("")
+    , m_encoding(0)
+    , m_guiType(0)
   {
   }
   //! the model
@@ -502,6 +518,12 @@ struct State {
   std::vector<librevenge::RVNGString> m_sheetNames;
   //! the main page style
   librevenge::RVNGString m_pageStyle;
+  //! the StarCalcDocument ole name
+  std::string m_calcDocumentName;
+  //! the StarCalcDocument encoding (a StarEncoding::Encoding)
+  int m_encoding;
+  //! the StarCalcDocument GUI type
+  int m_guiType;
 };
 
 ////////////////////////////////////////
@@ -750,6 +772,399 @@ bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell,
   return true;
 }
 
+////////////////////////////////////////////////////////////
+// index
+////////////////////////////////////////////////////////////
+namespace StarObjectSpreadsheetInternal
+{
+//! appends a little endian number to a binary data
+static void appendULong(librevenge::RVNGBinaryData &data, unsigned long val, int num)
+{
+  for (int i=0; i<num; ++i, val>>=8)
+    data.append(static_cast<unsigned char>(val&0xFF));
+}
+}
+
+bool StarObjectSpreadsheet::Index::computeChecksum(STOFFInputStreamPtr input, uint32_t &checksum)
+{
+  checksum=0;
+  if (!input) return false;
+  // Adler-32
+  uint32_t a=1, b=0;
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  while (!input->isEnd()) {
+    unsigned long numRead;
+    uint8_t const *data=input->read(5552, numRead);
+    if (!data || !numRead) break;
+    for (unsigned long i=0; i<numRead; ++i) {
+      a+=data[i];
+      b+=a;
+    }
+    a%=65521;
+    b%=65521;
+  }
+  checksum=(b<<16)|a;
+  return input->tell()==input->size();
+}
+
+bool StarObjectSpreadsheet::Index::write(librevenge::RVNGBinaryData &data) const
+{
+  data.clear();
+  if (m_streamSize<=0) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::write: the index seems empty\n"));
+    return false;
+  }
+  data.append(reinterpret_cast<unsigned char const *>("SDCI"), 4);
+  StarObjectSpreadsheetInternal::appendULong(data, 1, 2); // version
+  StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(m_streamSize), 4);
+  StarObjectSpreadsheetInternal::appendULong(data, m_checksum, 4);
+  StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(m_encoding), 2);
+  StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(m_guiType), 2);
+  StarObjectSpreadsheetInternal::appendULong(data, m_tableList.size(), 2);
+  for (auto const &table : m_tableList) {
+    auto nameLength=std::strlen(table.m_name.cstr());
+    if (nameLength>0xFFFF) nameLength=0xFFFF;
+    StarObjectSpreadsheetInternal::appendULong(data, nameLength, 2);
+    data.append(reinterpret_cast<unsigned char const *>(table.m_name.cstr()), nameLength);
+    StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(table.m_position), 4);
+    StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(table.m_loadingVersion), 2);
+    StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(table.m_maxRow), 4);
+    StarObjectSpreadsheetInternal::appendULong(data, table.m_columnList.size(), 2);
+    for (auto const &col : table.m_columnList) {
+      StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(col.m_column), 2);
+      StarObjectSpreadsheetInternal::appendULong(data, col.m_dataPositionList.size(), 2);
+      for (auto pos : col.m_dataPositionList)
+        StarObjectSpreadsheetInternal::appendULong(data, static_cast<unsigned long>(pos), 4);
+    }
+  }
+  return true;
+}
+
+bool StarObjectSpreadsheet::Index::read(librevenge::RVNGBinaryData const &data)
+{
+  *this=Index();
+  auto input=STOFFInputStream::get(data, true);
+  if (!input || input->size()<20) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::read: the data seems too short\n"));
+    return false;
+  }
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  std::string magic("");
+  for (int i=0; i<4; ++i) magic+=char(input->readULong(1));
+  if (magic!="SDCI" || input->readULong(2)!=1) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::read: unknown header\n"));
+    return false;
+  }
+  m_streamSize=long(input->readULong(4));
+  m_checksum=uint32_t(input->readULong(4));
+  m_encoding=int(input->readULong(2));
+  m_guiType=int(input->readULong(2));
+  auto nTables=int(input->readULong(2));
+  for (int t=0; t<nTables; ++t) {
+    Table table;
+    auto nameLength=long(input->readULong(2));
+    if (!input->checkPosition(input->tell()+nameLength+12)) {
+      STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::read: can not read table %d\n", t));
+      *this=Index();
+      return false;
+    }
+    std::string name("");
+    for (long c=0; c<nameLength; ++c) name+=char(input->readULong(1));
+    table.m_name=name.c_str();
+    table.m_position=long(input->readULong(4));
+    table.m_loadingVersion=int(input->readULong(2));
+    table.m_maxRow=int(input->readULong(4));
+    auto nColumns=int(input->readULong(2));
+    for (int c=0; c<nColumns; ++c) {
+      Column col;
+      col.m_column=int(input->readULong(2));
+      auto nData=long(input->readULong(2));
+      if (!input->checkPosition(input->tell()+4*nData)) {
+        STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::read: can not read column %d\n", c));
+        *this=Index();
+        return false;
+      }
+      for (long d=0; d<nData; ++d) {
+        auto pos=long(input->readULong(4));
+        if (pos<=0 || pos>=m_streamSize) {
+          STOFF_DEBUG_MSG(("StarObjectSpreadsheet::Index::read: find a bad position\n"));
+          *this=Index();
+          return false;
+        }
+        col.m_dataPositionList.push_back(pos);
+      }
+      table.m_columnList.push_back(col);
+    }
+    m_tableList.push_back(table);
+  }
+  return true;
+}
+
+bool StarObjectSpreadsheet::createIndex(StarObjectSpreadsheet::Index &index)
+{
+  index=Index();
+  if (m_spreadsheetState->m_calcDocumentName.empty() || !getOLEDirectory() || !getOLEDirectory()->m_input) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::createIndex: the document is not parsed\n"));
+    return false;
+  }
+  auto input=getOLEDirectory()->m_input->getSubStreamByName(m_spreadsheetState->m_calcDocumentName);
+  if (!input || !Index::computeChecksum(input, index.m_checksum)) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::createIndex: can not compute the checksum\n"));
+    return false;
+  }
+  index.m_streamSize=input->size();
+  index.m_encoding=m_spreadsheetState->m_encoding;
+  index.m_guiType=m_spreadsheetState->m_guiType;
+  for (auto const &table : m_spreadsheetState->m_tableList) {
+    Index::Table tableIndex;
+    if (table) {
+      tableIndex.m_name=table->m_name;
+      tableIndex.m_position=table->m_position;
+      tableIndex.m_loadingVersion=table->getLoadingVersion();
+      tableIndex.m_maxRow=table->getMaxRows();
+      for (auto const &it : table->m_columnToDataPositionsMap) {
+        Index::Column col;
+        col.m_column=it.first;
+        col.m_dataPositionList=it.second;
+        tableIndex.m_columnList.push_back(col);
+      }
+    }
+    index.m_tableList.push_back(tableIndex);
+  }
+  return true;
+}
+
+bool StarObjectSpreadsheet::readCells(StarObjectSpreadsheet::Index const &index, int table, int column, STOFFVec2i const &rows,
+                                      librevenge::RVNGPropertyListVector &cells, bool checkIndex)
+try
+{
+  cells.clear();
+  if (table<0 || table>=int(index.m_tableList.size()) || !getOLEDirectory() || !getOLEDirectory()->m_input) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readCells: called with bad arguments\n"));
+    return false;
+  }
+  auto &directory=*getOLEDirectory();
+  STOFFInputStreamPtr input;
+  std::string name;
+  for (auto &content : directory.m_contentList) {
+    if (content.getBaseName()!="StarCalcDocument") continue;
+    name=content.getOleName();
+    input=directory.m_input->getSubStreamByName(name);
+    break;
+  }
+  uint32_t checksum;
+  if (!input || input->size()!=index.m_streamSize ||
+      (checkIndex && (!Index::computeChecksum(input, checksum) || checksum!=index.m_checksum))) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readCells: the index does not correspond to the StarCalcDocument zone\n"));
+    return false;
+  }
+  input->setReadInverted(true);
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  StarZone zone(input, name, "SWCalcDocument", getPassword());
+  uint16_t nId;
+  *input>>nId;
+  if ((nId>>8)!=0x42) {
+    input=StarEncryption::decodeStream(input, StarEncryption::getMaskToDecodeStream(uint8_t(nId>>8), 0x42));
+    if (!input) {
+      STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readCells: can not decode the stream\n"));
+      return false;
+    }
+    zone.setInput(input);
+  }
+  zone.setEncoding(StarEncoding::Encoding(index.m_encoding));
+  zone.setGuiType(index.m_guiType);
+
+  auto const &tableIndex=index.m_tableList[size_t(table)];
+  StarObjectSpreadsheetInternal::Table sheet(tableIndex.m_loadingVersion, tableIndex.m_maxRow);
+  for (auto const &col : tableIndex.m_columnList) {
+    if (col.m_column!=column) continue;
+    for (auto pos : col.m_dataPositionList) {
+      if (!input->checkPosition(pos) || input->seek(pos, librevenge::RVNG_SEEK_SET)!=0 || !readSCData(zone, sheet, column, &rows)) {
+        STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readCells: can not read a data zone\n"));
+        return false;
+      }
+    }
+  }
+
+  std::vector<librevenge::RVNGString> sheetNames;
+  for (auto const &t : index.m_tableList)
+    sheetNames.push_back(t.m_name);
+  for (auto &it : sheet.m_rowToRowContentMap) {
+    for (auto &cIt : it.second.m_colToCellMap) {
+      if (!cIt.second) continue;
+      auto &cell=*cIt.second;
+      auto &content=cell.m_content;
+      librevenge::RVNGPropertyList propList;
+      propList.insert("librevenge:column", column);
+      propList.insert("librevenge:row", cell.position()[1]);
+      if (!content.m_formula.empty()) {
+        StarCellFormula::updateFormula(content, sheetNames, table);
+        librevenge::RVNGPropertyListVector formulaVect;
+        for (auto const &f : content.m_formula) {
+          if (f.m_type!=STOFFCellContent::FormulaInstruction::F_None)
+            formulaVect.append(f.getPropertyList());
+        }
+        propList.insert("librevenge:formula", formulaVect);
+      }
+      if (content.m_contentType==STOFFCellContent::C_TEXT_BASIC || content.m_contentType==STOFFCellContent::C_TEXT) {
+        std::vector<uint32_t> text=content.m_text;
+        if (content.m_contentType==STOFFCellContent::C_TEXT && cell.m_textZone)
+          cell.m_textZone->getText(text);
+        propList.insert("librevenge:value-type", "string");
+        propList.insert("librevenge:text", libstoff::getString(text));
+      }
+      else if (content.isValueSet()) {
+        propList.insert("librevenge:value-type", "float");
+        propList.insert("librevenge:value", content.m_value, librevenge::RVNG_GENERIC);
+      }
+      cells.append(propList);
+    }
+  }
+  return true;
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readCells: catch an exception\n"));
+  return false;
+}
+
+////////////////////////////////////////////////////////////
+// columnar extraction
+////////////////////////////////////////////////////////////
+namespace StarObjectSpreadsheetInternal
+{
+//! returns a formula as a string: =FUNC(A1;$B$2:C3)
+static std::string getFormulaString(std::vector<STOFFCellContent::FormulaInstruction> const &formula)
+{
+  std::stringstream s;
+  s << std::setprecision(15) << "=";
+  for (auto const &inst : formula) {
+    switch (inst.m_type) {
+    case STOFFCellContent::FormulaInstruction::F_Operator:
+    case STOFFCellContent::FormulaInstruction::F_Function:
+      s << inst.m_content.cstr();
+      break;
+    case STOFFCellContent::FormulaInstruction::F_Text: {
+      s << "\"";
+      for (char const *c=inst.m_content.cstr(); *c; ++c) {
+        if (*c=='"') s << '"';
+        s << *c;
+      }
+      s << "\"";
+      break;
+    }
+    case STOFFCellContent::FormulaInstruction::F_Long:
+      s << inst.m_longValue;
+      break;
+    case STOFFCellContent::FormulaInstruction::F_Double:
+      s << inst.m_doubleValue;
+      break;
+    case STOFFCellContent::FormulaInstruction::F_Cell:
+      if (!inst.m_sheet.empty()) s << inst.m_sheet.cstr() << ".";
+      s << libstoff::getCellName(inst.m_position[0],inst.m_positionRelative[0]);
+      break;
+    case STOFFCellContent::FormulaInstruction::F_CellList:
+      if (!inst.m_sheet.empty()) s << inst.m_sheet.cstr() << ".";
+      s << libstoff::getCellName(inst.m_position[0],inst.m_positionRelative[0]) << ":"
+        << libstoff::getCellName(inst.m_position[1],inst.m_positionRelative[1]);
+      break;
+    case STOFFCellContent::FormulaInstruction::F_Index:
+    case STOFFCellContent::FormulaInstruction::F_None:
+#if !defined(__clang__)
+    default:
+#endif
+      break;
+    }
+  }
+  return s.str();
+}
+}
+
+bool StarObjectSpreadsheet::sendColumns(STOFFDocument::ColumnCallback &callback)
+{
+  auto const &sheetNames=m_spreadsheetState->m_sheetNames;
+  // the buffers of the column's types and values, reused for each column
+  std::vector<STOFFDocument::SpreadsheetColumn::CellType> types;
+  std::vector<double> values;
+  for (size_t t=0; t<m_spreadsheetState->m_tableList.size(); ++t) {
+    if (!m_spreadsheetState->m_tableList[t]) continue;
+    auto &sheet=*m_spreadsheetState->m_tableList[t];
+    // the cells which are not empty, sorted by column and by row
+    std::map<int, std::vector<std::pair<int, StarObjectSpreadsheetInternal::Cell *> > > columnToCellsMap;
+    for (auto &it : sheet.m_rowToRowContentMap) {
+      STOFFVec2i const &rows=it.first;
+      for (auto &cIt : it.second.m_colToCellMap) {
+        if (!cIt.second || cIt.second->m_content.empty()) continue;
+        auto &cells=columnToCellsMap[cIt.first];
+        for (int row=rows[0]; row<=rows[1]; ++row)
+          cells.push_back(std::make_pair(row, cIt.second.get()));
+      }
+    }
+    for (auto &it : columnToCellsMap) {
+      auto &cells=it.second;
+      std::sort(cells.begin(), cells.end(),
+      [](std::pair<int, StarObjectSpreadsheetInternal::Cell *> const &c1, std::pair<int, StarObjectSpreadsheetInternal::Cell *> const &c2) {
+        return c1.first<c2.first;
+      });
+      STOFFDocument::SpreadsheetColumn column;
+      column.m_column=it.first;
+      column.m_firstRow=cells.front().first;
+      auto numRows=size_t(cells.back().first-column.m_firstRow+1);
+      types.assign(numRows, STOFFDocument::SpreadsheetColumn::C_EMPTY);
+      values.assign(numRows, std::numeric_limits<double>::quiet_NaN());
+      StarObjectSpreadsheetInternal::Cell const *lastCell=nullptr;
+      size_t lastId=0;
+      librevenge::RVNGString text, formula;
+      for (auto const &c : cells) {
+        auto id=size_t(c.first-column.m_firstRow);
+        // the rows are sorted, so the strings of the missing rows are appended first
+        while (size_t(column.m_texts.size())<id) {
+          column.m_texts.append("");
+          column.m_formulas.append("");
+        }
+        auto &cell=*c.second;
+        if (&cell==lastCell) {
+          // a repeated row: the cell's data are already computed
+          types[id]=types[lastId];
+          values[id]=values[lastId];
+          column.m_texts.append(text);
+          column.m_formulas.append(formula);
+          continue;
+        }
+        lastCell=&cell;
+        lastId=id;
+        text.clear();
+        formula.clear();
+        auto &content=cell.m_content;
+        if (!content.m_formula.empty()) {
+          StarCellFormula::updateFormula(content, sheetNames, int(t));
+          types[id]=STOFFDocument::SpreadsheetColumn::C_FORMULA;
+          formula=StarObjectSpreadsheetInternal::getFormulaString(content.m_formula).c_str();
+        }
+        else if (content.m_contentType==STOFFCellContent::C_TEXT_BASIC || content.m_contentType==STOFFCellContent::C_TEXT)
+          types[id]=STOFFDocument::SpreadsheetColumn::C_TEXT;
+        else if (content.isValueSet())
+          types[id]=STOFFDocument::SpreadsheetColumn::C_NUMBER;
+        if (content.isValueSet())
+          values[id]=content.m_value;
+        if (content.m_contentType==STOFFCellContent::C_TEXT_BASIC || content.m_contentType==STOFFCellContent::C_TEXT) {
+          std::vector<uint32_t> cellText=content.m_text;
+          if (content.m_contentType==STOFFCellContent::C_TEXT && cell.m_textZone)
+            cell.m_textZone->getText(cellText);
+          text=libstoff::getString(cellText);
+        }
+        column.m_texts.append(text);
+        column.m_formulas.append(formula);
+      }
+      column.m_numRows=static_cast<unsigned long>(numRows);
+      column.m_types=types.data();
+      column.m_values=values.data();
+      callback.insertColumn(int(t), sheet.m_name, column);
+    }
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////
 // main zone
 ////////////////////////////////////////////////////////////
@@ -805,8 +1220,10 @@ bool StarObjectSpreadsheet::parse()
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::parser: can not find the main calc document\n"));
     return false;
   }
-  else
+  else {
+    m_spreadsheetState->m_calcDocumentName=mainName;
     readCalcDocument(mainOle,mainName);
+  }
   return true;
 }
 
@@ -858,6 +1275,7 @@ try
       f << "table,";
       std::shared_ptr<StarObjectSpreadsheetInternal::Table> table;
       table.reset(new StarObjectSpreadsheetInternal::Table(version, maxRow));
+      table->m_position=input->tell();
       m_spreadsheetState->m_tableList.push_back(table);
       ok=readSCTable(zone, *table);
       break;
@@ -1672,6 +2090,8 @@ try
     zone.closeSCRecord("SCCalcDocument");
   }
   zone.closeSCRecord("SCCalcDocument");
+  m_spreadsheetState->m_encoding=int(zone.getEncoding());
+  m_spreadsheetState->m_guiType=zone.getGuiType();
   return true;
 }
 catch (...)
@@ -2086,6 +2506,7 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
     f.str("");
     f << "SCColumn[" << std::hex << id << std::dec << "]:";
     if (id==0x4250 && readSCData(zone,table,column)) {
+      table.m_columnToDataPositionsMap[column].push_back(pos+2);
       f << "data,";
       ascFile.addPos(pos);
       ascFile.addNote(f.str().c_str());
@@ -2192,7 +2613,7 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
   return true;
 }
 
-bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column)
+bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, STOFFVec2i const *rows)
 {
   STOFFInputStreamPtr input=zone.input();
   long pos=input->tell();
@@ -2213,6 +2634,7 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
 
   long lastPos=zone.getRecordLastPosition();
   int const version=table.getLoadingVersion();
+  StarObjectSpreadsheetInternal::Cell skippedCell;
   for (int i=0; i<count; ++i) {
     pos=input->tell();
     f.str("");
@@ -2229,7 +2651,8 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
     uint8_t what;
     *input>>what;
     bool ok=true;
-    auto &cell=table.getCell(STOFFVec2i(column, row));
+    bool const skip=rows && (row<(*rows)[0] || row>(*rows)[1]);
+    auto &cell=skip ? skippedCell : table.getCell(STOFFVec2i(column, row));
     STOFFCell::Format format=cell.getFormat();
     switch (what) {
     case 1: { // value
@@ -2281,6 +2704,11 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
         break;
       }
       long endDataPos=scRecord.getContentLastPosition();
+      if (skip) {
+        input->seek(endDataPos, librevenge::RVNG_SEEK_SET);
+        scRecord.closeContent("SCData");
+        break;
+      }
       if (version>=8) {
         auto cData=int(input->readULong(1));
         if ((cData&0x10) && (cData&0xf)>=4) {
@@ -2578,7 +3006,7 @@ bool StarObjectSpreadsheet::readSCChangeTrack(StarZone &zone, int /*version*/, l
     pos=input->tell();
     f.str("");
     f << "Entries(SCChangeTrack)[L]:###";
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCChangeTrack: reading the action links is not implemented\n"));
       first=false;
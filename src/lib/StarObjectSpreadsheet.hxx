@@ -63,6 +63,75 @@ class STOFFPageSpan;
 class StarObjectSpreadsheet final : public StarObject
 {
 public:
+  /** \brief a small index which stores the position of the tables, columns and data
+      blocks of a StarCalcDocument zone
+
+      \note it can be stored and retrieved latter to read the content of some cells
+      without parsing again the whole document
+   */
+  struct Index {
+    //! the column positions
+    struct Column {
+      //! constructor
+      Column()
+        : m_column(0)
+        , m_dataPositionList()
+      {
+      }
+      //! the column id
+      int m_column;
+      //! the SCData begin positions
+      std::vector<long> m_dataPositionList;
+    };
+    //! the table positions
+    struct Table {
+      //! constructor
+      Table()
+        : m_name("")
+        , m_position(0)
+        , m_loadingVersion(0)
+        , m_maxRow(8191)
+        , m_columnList()
+      {
+      }
+      //! the table name
+      librevenge::RVNGString m_name;
+      //! the SCTable begin position
+      long m_position;
+      //! the loading version
+      int m_loadingVersion;
+      //! the maximum row
+      int m_maxRow;
+      //! the list of columns
+      std::vector<Column> m_columnList;
+    };
+    //! constructor
+    Index()
+      : m_streamSize(0)
+      , m_checksum(0)
+      , m_encoding(0)
+      , m_guiType(0)
+      , m_tableList()
+    {
+    }
+    //! try to store the index in a binary data
+    bool write(librevenge::RVNGBinaryData &data) const;
+    //! try to read an index from a binary data
+    bool read(librevenge::RVNGBinaryData const &data);
+    //! computes the Adler-32 checksum of a stream
+    static bool computeChecksum(STOFFInputStreamPtr input, uint32_t &checksum);
+    //! the StarCalcDocument stream size
+    long m_streamSize;
+    //! the StarCalcDocument stream checksum
+    uint32_t m_checksum;
+    //! the zone encoding (a StarEncoding::Encoding)
+    int m_encoding;
+    //! the zone GUI type
+    int m_guiType;
+    //! the list of table
+    std::vector<Table> m_tableList;
+  };
+
   //! constructor
   StarObjectSpreadsheet(StarObject const &orig, bool duplicateState);
   //! destructor
@@ -79,6 +148,19 @@ public:
   bool sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener);
   /** try to update the page span */
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
+  /** try to create the index of the tables, columns and data positions (must be called after parse) */
+  bool createIndex(Index &index);
+  /** try to read the cells of a column with rows in [rows[0],rows[1]] using an index,
+      each cell is stored as a property list in cells.
+
+      \note this function does not need to parse the document, it only reads the data
+      blocks of the column. The stream size is always compared with the index one, the stream checksum
+      only if checkIndex is set. */
+  bool readCells(Index const &index, int table, int column, STOFFVec2i const &rows, librevenge::RVNGPropertyListVector &cells, bool checkIndex=true);
+  /** try to send the content of the cells of each table column by column (must be called after parse)
+
+      \note no property list is created, the cells' formats are ignored */
+  bool sendColumns(STOFFDocument::ColumnCallback &callback);
 protected:
   //
   // data
@@ -92,8 +174,10 @@ protected:
   bool readSCTable(StarZone &zone, StarObjectSpreadsheetInternal::Table &table);
   //! try to read a SCColumn
   bool readSCColumn(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, long lastPos);
-  //! try to read a list of data
-  bool readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column);
+  /** try to read a list of data
+
+      \note if rows is set, only the cells whose rows are in [rows[0],rows[1]] are fully decoded */
+  bool readSCData(StarZone &zone, StarObjectSpreadsheetInternal::Table &table, int column, STOFFVec2i const *rows=nullptr);
 
   //! try to read a change trak
   bool readSCChangeTrack(StarZone &zone, int version, long lastPos);
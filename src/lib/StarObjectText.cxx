@@ -31,11 +31,13 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <set>
 #include <sstream>
 
 #include <librevenge/librevenge.h>
@@ -434,7 +436,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
   STOFFFont mainFont=state.m_font;
   listener->setFont(mainFont);
   if (!m_markList.empty()) {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: sorry mark are not implemented\n"));
       first=false;
@@ -518,7 +520,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
               state.m_global->m_pageNameList.push_back("");
             break;
           default: {
-            static bool first=true;
+            static std::atomic<bool> first(true);
             if (first) {
               first=false;
               STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: unexpected break\n"));
@@ -576,7 +578,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
         }
         listener->setParagraph(lineState.m_paragraph);
       }
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first && lineState.m_content) {
         first=false;
         STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: find unexpected content zone\n"));
@@ -716,6 +718,9 @@ struct State {
     , m_numericRuler()
     , m_pageStyle()
     , m_model()
+    , m_textCallback(nullptr)
+    , m_skippedRecords()
+    , m_numSkippedBytes(0)
   {
   }
   //! the number of pages
@@ -732,8 +737,49 @@ struct State {
   std::shared_ptr<StarObjectPageStyle> m_pageStyle;
   //! the drawing model
   std::shared_ptr<StarObjectModel> m_model;
+  //! the callback used to send the text (if we only read the text)
+  STOFFDocument::ParagraphCallback *m_textCallback;
+  //! the list of records of the main zone to skip
+  std::set<char> m_skippedRecords;
+  //! the number of bytes of the skipped records
+  long m_numSkippedBytes;
+private:
+  State(State const &orig);
+  State &operator=(State const &orig);
 };
 
+////////////////////////////////////////
+//! Internal: a callback used to count the paragraphs, words and characters
+struct StatisticsCallback final : public STOFFDocument::ParagraphCallback {
+  //! constructor
+  StatisticsCallback()
+    : STOFFDocument::ParagraphCallback()
+    , m_numParagraphs(0)
+    , m_numWords(0)
+    , m_numCharacters(0)
+  {
+  }
+  //! count the number of words and characters of a paragraph
+  void insertParagraph(librevenge::RVNGString const &text) final
+  {
+    ++m_numParagraphs;
+    bool inWord=false;
+    for (char const *ptr=text.cstr(); ptr && *ptr; ++ptr) {
+      auto c=static_cast<unsigned char>(*ptr);
+      if ((c&0xC0)==0x80) continue; // an UTF-8 continuation byte
+      ++m_numCharacters;
+      bool isSpace=c==' ' || c==0x9 || c==0xa;
+      if (!isSpace && !inWord) ++m_numWords;
+      inWord=!isSpace;
+    }
+  }
+  //! the number of paragraphs
+  long m_numParagraphs;
+  //! the number of words
+  long m_numWords;
+  //! the number of characters
+  long m_numCharacters;
+};
 }
 
 ////////////////////////////////////////////////////////////
@@ -899,6 +945,86 @@ bool StarObjectText::parse()
   return true;
 }
 
+void StarObjectText::setSkippedRecords(std::string const &records)
+{
+  m_textState->m_skippedRecords.clear();
+  for (auto c : records) {
+    if (c=='U' || c=='V' || c=='M' || c=='j' || c=='d')
+      m_textState->m_skippedRecords.insert(c);
+    else {
+      STOFF_DEBUG_MSG(("StarObjectText::setSkippedRecords: record %c can not be skipped\n", c));
+    }
+  }
+}
+
+long StarObjectText::getNumSkippedBytes() const
+{
+  return m_textState->m_numSkippedBytes;
+}
+
+bool StarObjectText::readText(STOFFInputStreamPtr input, std::string const &name, STOFFDocument::ParagraphCallback &callback)
+{
+  if (!input) {
+    STOFF_DEBUG_MSG(("StarObjectText::readText: called without input\n"));
+    return false;
+  }
+  input->setReadInverted(true);
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  m_textState->m_textCallback=&callback;
+  bool ok=readWriterDocument(input, name);
+  m_textState->m_textCallback=nullptr;
+  return ok;
+}
+
+bool StarObjectText::readStatistics(STOFFInputStreamPtr input, std::string const &name, librevenge::RVNGPropertyList &statistics)
+{
+  statistics.clear();
+  if (!input) {
+    STOFF_DEBUG_MSG(("StarObjectText::readStatistics: called without input\n"));
+    return false;
+  }
+  input->setReadInverted(true);
+  input->seek(0, librevenge::RVNG_SEEK_SET);
+  StarZone zone(input, name, "SWWriterDocument", getPassword());
+  if (!zone.readSWHeader()) {
+    STOFF_DEBUG_MSG(("StarObjectText::readStatistics: can not read the header\n"));
+    return false;
+  }
+  // look for the statistics zone, skipping the other zones
+  while (!input->isEnd()) {
+    long pos=input->tell();
+    if (input->peek()=='d') {
+      StarWriterStruct::DocStats stats;
+      if (!stats.read(zone))
+        break;
+      static char const *wh[]= {
+        "meta:table-count", "meta:image-count", "meta:object-count", "meta:page-count",
+        "meta:paragraph-count", "meta:word-count", "meta:character-count"
+      };
+      for (int i=0; i<7; ++i)
+        statistics.insert(wh[i], int(stats.m_numbers[i]));
+      return true;
+    }
+    char type;
+    if (!zone.openSWRecord(type)) {
+      input->seek(pos, librevenge::RVNG_SEEK_SET);
+      break;
+    }
+    zone.closeSWRecord(type, "SWWriterDocument");
+    if (type=='Z')
+      break;
+  }
+  // no statistics, try to count the paragraphs, words and characters of the main text
+  STOFF_DEBUG_MSG(("StarObjectText::readStatistics: can not find the statistics zone, count the text\n"));
+  StarObjectTextInternal::StatisticsCallback callback;
+  if (!readText(input, name, callback))
+    return false;
+  statistics.insert("meta:paragraph-count", int(callback.m_numParagraphs));
+  statistics.insert("meta:word-count", int(callback.m_numWords));
+  statistics.insert("meta:character-count", int(callback.m_numCharacters));
+  return true;
+}
+
 bool StarObjectText::readSfxStyleSheets(STOFFInputStreamPtr input, std::string const &name)
 {
   StarZone zone(input, name, "SfxStyleSheets", getPassword());
@@ -1000,6 +1126,15 @@ bool StarObjectText::readSWContent(StarZone &zone, std::shared_ptr<StarObjectTex
     if (input->tell()>=lastPos) break;
     pos=input->tell();
     int cType=input->peek();
+    if (m_textState->m_textCallback && cType!='E' && cType!='I' && cType!='T') {
+      // text only: skip the graphic, ole, format, ... nodes
+      if (!zone.openSWRecord(type)) {
+        input->seek(pos, librevenge::RVNG_SEEK_SET);
+        break;
+      }
+      zone.closeSWRecord(type, "SWContent");
+      continue;
+    }
     bool done=false;
     switch (cType) {
     case 'E': {
@@ -1488,6 +1623,17 @@ bool StarObjectText::readSWTextZone(StarZone &zone, std::shared_ptr<StarObjectTe
 
   ascFile.addPos(pos);
   ascFile.addNote(f.str().c_str());
+  if (m_textState->m_textCallback) {
+    // text only: remove the attribute's placeholders and skip the attributes
+    std::vector<uint32_t> text;
+    for (auto c : textZone->m_text) {
+      if (c>=0x20 || c==0x9 || c==0xa)
+        text.push_back(c);
+    }
+    m_textState->m_textCallback->insertParagraph(libstoff::getString(text));
+    zone.closeSWRecord('T', "SWText");
+    return true;
+  }
 
   long lastPos=zone.getRecordLastPosition();
   std::vector<std::shared_ptr<StarAttribute> > attributeList;
@@ -1722,6 +1868,30 @@ try
   while (!input->isEnd()) {
     long pos=input->tell();
     int rType=input->peek();
+    if (m_textState->m_skippedRecords.find(char(rType))!=m_textState->m_skippedRecords.end()) {
+      char type;
+      if (!zone.openSWRecord(type)) {
+        input->seek(pos, librevenge::RVNG_SEEK_SET);
+        break;
+      }
+      m_textState->m_numSkippedBytes+=zone.getRecordLastPosition()-pos;
+      ascFile.addPos(pos);
+      ascFile.addNote("SWWriterDocument:skipped");
+      zone.closeSWRecord(type, "SWWriterDocument");
+      continue;
+    }
+    if (m_textState->m_textCallback && rType!='!' && rType!='N') {
+      // text only: skip the zone
+      char type;
+      if (!zone.openSWRecord(type)) {
+        input->seek(pos, librevenge::RVNG_SEEK_SET);
+        break;
+      }
+      zone.closeSWRecord(type, "SWWriterDocument");
+      if (type=='Z')
+        break;
+      continue;
+    }
     bool done=false;
     switch (rType) {
     case '!':
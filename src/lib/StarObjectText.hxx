@@ -107,11 +107,25 @@ public:
 
   // try to parse all zone
   bool parse();
+  /** set the list of ignorable records of the main zone which must be skipped without being decoded
+
+      \note only the records 'U' (layout), 'V' (redlines), 'M' (macros), 'j' (dictionaries) and 'd' (statistics) can be skipped */
+  void setSkippedRecords(std::string const &records);
+  //! returns the number of bytes of the records skipped in the main zone
+  long getNumSkippedBytes() const;
 
   /** try to update the page span (to create draw document)*/
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
   //! try to send the different page
   bool sendPages(STOFFTextListenerPtr &listener);
+  /** try to read only the text of a StarWriterDocument zone and to send each paragraph to a callback
+
+      \note the attributes, the formats, the fly frames, the layout and the pictures are skipped */
+  bool readText(STOFFInputStreamPtr input, std::string const &fileName, STOFFDocument::ParagraphCallback &callback);
+  /** try to read the document statistics stored in a StarWriterDocument zone: 'd'.
+      If this zone does not exist, computes the number of paragraphs, words and characters
+      by reading the main text */
+  bool readStatistics(STOFFInputStreamPtr input, std::string const &fileName, librevenge::RVNGPropertyList &statistics);
 
   //! try to read a image map zone : 'X'
   static bool readSWImageMap(StarZone &zone);
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cmath>
 #include <map>
 #include <set>
@@ -193,7 +194,7 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
     m_format->updateState(cState);
     if (cState.m_frame.m_position.m_size[0]<=0) {
       if (m_lineList.empty()) {
-        static bool first=true;
+        static std::atomic<bool> first(true);
         if (first) {
           STOFF_DEBUG_MSG(("StarTableInternal::TableBox::updatePosition: oops, can not find some box witdh\n"));
           first=false;
@@ -209,7 +210,7 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
     }
   }
   else if (m_lineList.empty()) {
-    static bool first=true;
+    static std::atomic<bool> first(true);
     if (first) {
       STOFF_DEBUG_MSG(("StarTableInternal::TableBox::updatePosition: oops, can not find some box witdh\n"));
       first=false;
@@ -306,7 +307,7 @@ bool TableBox::read(Table &table, StarZone &zone, StarObjectText &object, STOFFB
   m_position=STOFFBox2i(cPos.min(), maxPos);
   for (int i=0; i<2; ++i) {
     if (maxPos[i]>cPos[1][i]) {
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarTableInternal::TableBox::read: the dim %d number seems bad: %d>%d\n", i, maxPos[i], cPos[1][i]));
       }
@@ -433,7 +434,7 @@ bool TableLine::read(Table &table, StarZone &zone, StarObjectText &object, STOFF
   m_position=STOFFBox2i(cPos.min(), maxPos);
   for (int i=0; i<2; ++i) {
     if (maxPos[i]>cPos[1][i]) {
-      static bool first=true;
+      static std::atomic<bool> first(true);
       if (first) {
         STOFF_DEBUG_MSG(("StarTableInternal::TableLine::read: the dim %d number seems bad: %d>%d\n", i, maxPos[i], cPos[1][i]));
       }
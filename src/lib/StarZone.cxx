@@ -59,6 +59,7 @@ StarZone::StarZone(STOFFInputStreamPtr const &inputStream, std::string const &as
   , m_zoneName(zoneName)
   , m_typeStack()
   , m_positionStack()
+  , m_beginStack()
   , m_beginToEndMap()
   , m_flagEndZone()
   , m_poolList()
@@ -358,8 +359,7 @@ bool StarZone::openSCHHeader()
     m_input->seek(pos, librevenge::RVNG_SEEK_SET);
     return false;
   }
-  m_typeStack.push('@');
-  m_positionStack.push(endPos);
+  pushRecord('@', pos, endPos);
   return true;
 }
 
@@ -389,8 +389,7 @@ bool StarZone::openVersionCompatHeader()
     m_input->seek(pos, librevenge::RVNG_SEEK_SET);
     return false;
   }
-  m_typeStack.push('*');
-  m_positionStack.push(endPos);
+  pushRecord('*', pos, endPos);
   return true;
 }
 
@@ -402,6 +401,7 @@ bool StarZone::closeVersionCompatHeader(std::string const &debugName)
 
 bool StarZone::openSDRHeader(std::string &magic)
 {
+  libstoff::ParseControl::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   // svdio.cxx: SdrIOHeader::Read
@@ -409,8 +409,7 @@ bool StarZone::openSDRHeader(std::string &magic)
   for (int i=0; i<4; ++i) magic+=char(m_input->readULong(1));
   // special case: ok to have only magic if ...
   if (magic=="DrXX") {
-    m_typeStack.push('_');
-    m_positionStack.push(m_input->tell());
+    pushRecord('_', pos, m_input->tell());
     return true;
   }
   m_headerVersionStack.push(int(m_input->readULong(2)));
@@ -428,8 +427,7 @@ bool StarZone::openSDRHeader(std::string &magic)
     m_input->seek(pos, librevenge::RVNG_SEEK_SET);
     return false;
   }
-  m_typeStack.push('_');
-  m_positionStack.push(endPos);
+  pushRecord('_', pos, endPos);
   return true;
 }
 
@@ -444,16 +442,13 @@ bool StarZone::closeSDRHeader(std::string const &debugName)
 ////////////////////////////////////////////////////////////
 bool StarZone::openDummyRecord()
 {
-  m_typeStack.push('@');
-  if (!m_positionStack.empty())
-    m_positionStack.push(m_positionStack.top());
-  else
-    m_positionStack.push(m_input->size());
+  pushRecord('@', m_input->tell(), !m_positionStack.empty() ? m_positionStack.top() : m_input->size());
   return true;
 }
 
 bool StarZone::openRecord()
 {
+  libstoff::ParseControl::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
@@ -475,13 +470,13 @@ bool StarZone::openRecord()
     STOFF_DEBUG_MSG(("StarZone::openRecord: argh endPosition is not in the current group\n"));
     return false;
   }
-  m_typeStack.push(' ');
-  m_positionStack.push(endPos);
+  pushRecord(' ', pos, endPos);
   return true;
 }
 
 bool StarZone::openSCRecord()
 {
+  libstoff::ParseControl::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
@@ -499,13 +494,13 @@ bool StarZone::openSCRecord()
     STOFF_DEBUG_MSG(("StarZone::openSCRecord: argh endPosition is not in the current group\n"));
     return false;
   }
-  m_typeStack.push('_');
-  m_positionStack.push(endPos);
+  pushRecord('_', pos, endPos);
   return true;
 }
 
 bool StarZone::openSWRecord(char &type)
 {
+  libstoff::ParseControl::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long val=m_input->readULong(4);
@@ -542,13 +537,13 @@ bool StarZone::openSWRecord(char &type)
     STOFF_DEBUG_MSG(("StarZone::openSWRecord: argh endPosition is not in the current group\n"));
     return false;
   }
-  m_typeStack.push(type);
-  m_positionStack.push(endPos);
+  pushRecord(type, pos, endPos);
   return true;
 }
 
 bool StarZone::openSfxRecord(char &type)
 {
+  libstoff::ParseControl::check();
   long pos=m_input->tell();
   if (!m_input->checkPosition(pos+4)) return false;
   // filerec.cxx SfxMiniRecordReader::SfxMiniRecordReader
@@ -570,9 +565,17 @@ bool StarZone::openSfxRecord(char &type)
     STOFF_DEBUG_MSG(("StarZone::openSfxRecord: argh endPosition is not in the current group\n"));
     return false;
   }
+  pushRecord(type, pos, endPos);
+  return true;
+}
+
+void StarZone::pushRecord(char type, long beginPos, long endPos)
+{
   m_typeStack.push(type);
   m_positionStack.push(endPos);
-  return true;
+  // reading the clock is not free, so only do it when the parsing is profiled
+  m_beginStack.push(std::make_pair(beginPos, libstoff::ParseControl::isProfiling() ?
+                                   std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point()));
 }
 
 bool StarZone::closeRecord(char type, std::string const &debugName)
@@ -581,10 +584,15 @@ bool StarZone::closeRecord(char type, std::string const &debugName)
   while (!m_typeStack.empty()) {
     char typ=m_typeStack.top();
     long pos=m_positionStack.top();
+    auto begin=m_beginStack.top();
 
     m_typeStack.pop();
     m_positionStack.pop();
+    m_beginStack.pop();
     if (typ!=type) continue;
+    if (libstoff::ParseControl::isProfiling())
+      libstoff::ParseControl::addRecord(debugName, (pos ? pos : m_input->tell())-begin.first,
+                                        std::chrono::duration<double>(std::chrono::steady_clock::now()-begin.second).count());
     if (!pos || type=='@')
       return true;
     long actPos=m_input->tell();
@@ -38,8 +38,10 @@
 #ifndef STAR_ZONE
 #  define STAR_ZONE
 
-#include <vector>
+#include <chrono>
 #include <stack>
+#include <utility>
+#include <vector>
 
 #include "libstaroffice_internal.hxx"
 
@@ -141,7 +143,11 @@ public:
   // basic
   //
 
-  //! try to open a classic record: size (32 bytes) +  size-4 bytes
+  /** try to open a classic record: size (32 bytes) +  size-4 bytes
+
+      \note the open record functions throw a libstoff::CancelledException
+      if the current parsing is cancelled or if its time limit is reached
+   */
   bool openRecord();
   //! try to close a record
   bool closeRecord(std::string const &debugName)
@@ -267,6 +273,8 @@ protected:
 
   //! try to read the record sizes
   bool readRecordSizes(long pos);
+  //! pushes a new record in the stacks
+  void pushRecord(char type, long beginPos, long endPos);
   //! try to close a record
   bool closeRecord(char type, std::string const &debugName);
 
@@ -299,6 +307,8 @@ protected:
   std::stack<char> m_typeStack;
   //! the position stack
   std::stack<long> m_positionStack;
+  //! the begin position and the opening time stack (the time is only set when profiling)
+  std::stack<std::pair<long, std::chrono::steady_clock::time_point> > m_beginStack;
   //! other position to end position zone
   std::map<long, long> m_beginToEndMap;
   //! end of a cflags zone
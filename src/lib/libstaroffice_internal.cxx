@@ -31,9 +31,11 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <string>
 #include <sstream>
@@ -49,6 +51,74 @@
 /** namespace used to regroup all libwpd functions, enumerations which we have redefined for internal usage */
 namespace libstoff
 {
+thread_local ParseControl *ParseControl::s_current=nullptr;
+std::atomic<unsigned long> ParseControl::s_lastId(0);
+
+ParseControl::ParseControl(std::atomic<bool> const *cancel, double maxDuration, unsigned long maxMemory, unsigned long *usedMemory, bool profile)
+  : m_cancel(cancel)
+  , m_hasDeadline(maxDuration>0)
+  , m_deadline()
+  , m_numChecks(0)
+  , m_stopped(false)
+  , m_id(++s_lastId)
+  , m_maxMemory(maxMemory)
+  , m_usedMemory(0)
+  , m_peakMemory(0)
+  , m_usedMemoryPtr(usedMemory)
+  , m_memoryExceeded(false)
+  , m_profile(profile)
+  , m_recordCounters()
+  , m_allocationCounters()
+  , m_previous(s_current)
+{
+  if (m_hasDeadline)
+    m_deadline=std::chrono::steady_clock::now()+
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(maxDuration));
+  s_current=this;
+}
+
+ParseControl::~ParseControl()
+{
+  if (m_usedMemoryPtr)
+    *m_usedMemoryPtr=m_peakMemory;
+  s_current=m_previous;
+}
+
+void ParseControl::charge(char const *subsystem, unsigned long size)
+{
+  if (m_profile && subsystem) {
+    auto &counter=m_allocationCounters[subsystem];
+    ++counter.m_count;
+    counter.m_size+=size;
+  }
+  unsigned long const newUsedMemory=size>std::numeric_limits<unsigned long>::max()-m_usedMemory ?
+                                    std::numeric_limits<unsigned long>::max() : m_usedMemory+size;
+  if (newUsedMemory>m_peakMemory)
+    m_peakMemory=newUsedMemory;
+  if (!m_maxMemory || newUsedMemory<=m_maxMemory) {
+    m_usedMemory=newUsedMemory;
+    return;
+  }
+  // the allocation is not done, so it is not kept in the current usage
+  STOFF_DEBUG_MSG(("libstoff::ParseControl::charge: the memory budget is exceeded\n"));
+  m_memoryExceeded=m_stopped=true;
+  throw MemoryException();
+}
+
+bool ParseControl::mustStop()
+{
+  if (m_stopped) return true;
+  if (m_cancel && m_cancel->load(std::memory_order_relaxed))
+    m_stopped=true;
+  // reading the clock is not free, so only check the time limit from time to time
+  else if (m_hasDeadline && (++m_numChecks&0xff)==0 && std::chrono::steady_clock::now()>m_deadline)
+    m_stopped=true;
+  if (m_stopped) {
+    STOFF_DEBUG_MSG(("libstoff::ParseControl::mustStop: the parsing is stopped\n"));
+  }
+  return m_stopped;
+}
+
 uint8_t readU8(librevenge::RVNGInputStream *input)
 {
   unsigned long numBytesRead;
@@ -65,7 +135,7 @@ librevenge::RVNGString getString(std::vector<uint32_t> const &unicode)
   librevenge::RVNGString res("");
   for (unsigned int i : unicode) {
     if (i<0x20 && i!=0x9 && i!=0xa && i!=0xd) {
-      static int numErrors=0;
+      static std::atomic<int> numErrors(0);
       if (++numErrors<10) {
         STOFF_DEBUG_MSG(("libstoff::getString: find odd char %x\n", static_cast<unsigned int>(i)));
       }
@@ -344,6 +414,32 @@ bool STOFFEmbeddedObject::addTo(librevenge::RVNGPropertyList &propList) const
   return true;
 }
 
+// picture store function
+unsigned long STOFFPictureStore::hash(librevenge::RVNGBinaryData const &data)
+{
+  // FNV-1a
+  uint32_t res=2166136261U;
+  unsigned char const *ptr=data.getDataBuffer();
+  if (!ptr) return 0;
+  for (unsigned long i=0; i<data.size(); ++i)
+    res=(res^uint32_t(ptr[i]))*16777619U;
+  return static_cast<unsigned long>(res)^data.size();
+}
+
+librevenge::RVNGBinaryData const &STOFFPictureStore::get(librevenge::RVNGBinaryData const &data)
+{
+  if (data.empty())
+    return data;
+  unsigned long h=hash(data);
+  auto range=m_hashToDataMap.equal_range(h);
+  for (auto it=range.first; it!=range.second; ++it) {
+    auto const &stored=it->second;
+    if (stored.size()==data.size() && std::memcmp(stored.getDataBuffer(), data.getDataBuffer(), size_t(data.size()))==0)
+      return stored;
+  }
+  return m_hashToDataMap.insert(std::multimap<unsigned long, librevenge::RVNGBinaryData>::value_type(h, data))->second;
+}
+
 int STOFFEmbeddedObject::cmp(STOFFEmbeddedObject const &pict) const
 {
   if (m_typeList.size()!=pict.m_typeList.size())
@@ -411,6 +507,33 @@ bool convertToDateTime(uint32_t date, uint32_t time, std::string &dateTime)
   return true;
 }
 
+bool convertFileTimeToDateTime(unsigned long low, unsigned long high, std::string &dateTime)
+{
+  auto const fileTime=(static_cast<unsigned long long>(high&0xFFFFFFFF)<<32)|static_cast<unsigned long long>(low&0xFFFFFFFF);
+  auto seconds=fileTime/10000000;
+  auto days=long(seconds/86400);
+  seconds%=86400;
+  if (days>3000*366) {
+    STOFF_DEBUG_MSG(("libstoff:convertFileTimeToDateTime: the date seems bad\n"));
+    return false;
+  }
+  // convert the number of days since 1601/01/01 in a civil date, see H. Hinnant's days_from_civil
+  days+=719468-134774; // 134774: the number of days between 1601/01/01 and 1970/01/01
+  long const era=(days>=0 ? days : days-146096)/146097;
+  long const doe=days-era*146097;
+  long const yoe=(doe-doe/1460+doe/36524-doe/146096)/365;
+  long const doy=doe-(365*yoe+yoe/4-yoe/100);
+  long const mp=(5*doy+2)/153;
+  long const day=doy-(153*mp+2)/5+1;
+  long const month=mp<10 ? mp+3 : mp-9;
+  long const year=yoe+era*400+(month<=2 ? 1 : 0);
+  std::stringstream s;
+  s << std::setfill('0') << std::setw(4) << year << "-" << std::setw(2) << month << "-" << std::setw(2) << day << "T"
+    << std::setw(2) << seconds/3600 << ":" << std::setw(2) << (seconds/60)%60 << ":" << std::setw(2) << seconds%60;
+  dateTime=s.str();
+  return true;
+}
+
 void splitString(librevenge::RVNGString const &string, librevenge::RVNGString const &delim,
                  librevenge::RVNGString &string1, librevenge::RVNGString &string2)
 {
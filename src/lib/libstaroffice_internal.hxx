@@ -40,6 +40,8 @@
 #include <stdio.h>
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <map>
@@ -151,6 +153,209 @@ class GenericException
 class WrongPasswordException
 {
 };
+
+//! exception thrown when the parsing is cancelled or when its time limit is reached
+class CancelledException
+{
+};
+
+//! exception thrown when the memory budget of the parsing is exceeded
+class MemoryException
+{
+};
+
+/** \brief small class used to stop the parsing of the current thread when it
+    is cancelled, when its time limit is reached or when it exceeds its memory
+    budget, and to profile it
+
+    \note the control is stored in a thread local variable, so that the zones
+    can check it at each record without having it passed through all the objects.
+ */
+class ParseControl
+{
+public:
+  //! a profile counter
+  struct Counter {
+    //! constructor
+    Counter()
+      : m_count(0)
+      , m_size(0)
+      , m_time(0)
+    {
+    }
+    //! the number of calls
+    unsigned long m_count;
+    //! the total size
+    unsigned long m_size;
+    //! the total time in seconds
+    double m_time;
+  };
+  /** constructor: installs the control in the current thread
+
+      \note if usedMemory is set, it is filled with the peak of the charged memory when the control is destroyed */
+  ParseControl(std::atomic<bool> const *cancel, double maxDuration, unsigned long maxMemory=0, unsigned long *usedMemory=nullptr, bool profile=false);
+  //! destructor: restores the previous control
+  ~ParseControl();
+  //! returns true if the parsing has been stopped
+  bool isStopped() const
+  {
+    return m_stopped;
+  }
+  //! returns true if the memory budget has been exceeded
+  bool isMemoryExceeded() const
+  {
+    return m_memoryExceeded;
+  }
+  //! throws a CancelledException if the parsing of the current thread must be stopped
+  static void check()
+  {
+    if (s_current && s_current->mustStop())
+      throw CancelledException();
+  }
+  /** charges the size of a big allocation done by a subsystem to the parsing of the current thread,
+      throws a MemoryException if the memory budget is exceeded
+
+      \note the owner of the allocation must give it back with releaseMemory, MemoryCharge does it */
+  static void chargeMemory(char const *subsystem, unsigned long size)
+  {
+    if (s_current)
+      s_current->charge(subsystem, size);
+  }
+  /** gives back some memory charged to the control controlId, does nothing if this control
+      is no longer the control of the current thread */
+  static void releaseMemory(unsigned long controlId, unsigned long size)
+  {
+    if (s_current && s_current->m_id==controlId)
+      s_current->m_usedMemory=size<s_current->m_usedMemory ? s_current->m_usedMemory-size : 0;
+  }
+  //! returns the identifier of the control of the current thread (or 0)
+  static unsigned long getCurrentId()
+  {
+    return s_current ? s_current->m_id : 0;
+  }
+  //! returns true if the parsing of the current thread is profiled
+  static bool isProfiling()
+  {
+    return s_current && s_current->m_profile;
+  }
+  //! adds a record to the profile of the current thread
+  static void addRecord(std::string const &name, long size, double time)
+  {
+    if (!s_current || !s_current->m_profile) return;
+    auto &counter=s_current->m_recordCounters[name];
+    ++counter.m_count;
+    if (size>0) counter.m_size+=static_cast<unsigned long>(size);
+    counter.m_time+=time;
+  }
+  //! returns the record counters
+  std::map<std::string, Counter> const &getRecordCounters() const
+  {
+    return m_recordCounters;
+  }
+  //! returns the allocation counters
+  std::map<std::string, Counter> const &getAllocationCounters() const
+  {
+    return m_allocationCounters;
+  }
+protected:
+  //! returns true if the parsing must be stopped
+  bool mustStop();
+  //! charges some memory
+  void charge(char const *subsystem, unsigned long size);
+  //! the cancel flag
+  std::atomic<bool> const *m_cancel;
+  //! a flag to know if there is a time limit
+  bool m_hasDeadline;
+  //! the time limit
+  std::chrono::steady_clock::time_point m_deadline;
+  //! the number of checks
+  unsigned m_numChecks;
+  //! a flag to know if the parsing has been stopped
+  bool m_stopped;
+  //! the control identifier
+  unsigned long m_id;
+  //! the memory budget: 0 means no limit
+  unsigned long m_maxMemory;
+  //! the memory currently charged
+  unsigned long m_usedMemory;
+  //! the peak of the charged memory
+  unsigned long m_peakMemory;
+  //! a pointer to store the peak of the charged memory (or null)
+  unsigned long *m_usedMemoryPtr;
+  //! a flag to know if the memory budget has been exceeded
+  bool m_memoryExceeded;
+  //! a flag to know if the parsing is profiled
+  bool m_profile;
+  //! the counters by record name
+  std::map<std::string, Counter> m_recordCounters;
+  //! the counters by allocation subsystem
+  std::map<std::string, Counter> m_allocationCounters;
+  //! the previous control of this thread
+  ParseControl *m_previous;
+  //! the control of the current thread
+  static thread_local ParseControl *s_current;
+  //! the last control identifier
+  static std::atomic<unsigned long> s_lastId;
+private:
+  ParseControl(ParseControl const &);
+  ParseControl &operator=(ParseControl const &);
+};
+
+/** \brief small class used by the owner of a big buffer to charge it to the
+    parsing of the current thread and to give it back when the buffer is released
+
+    \note a copy does not share the charge of the original */
+class MemoryCharge
+{
+public:
+  //! constructor
+  MemoryCharge()
+    : m_controlId(0)
+    , m_size(0)
+  {
+  }
+  //! copy constructor: the charge is not copied
+  MemoryCharge(MemoryCharge const &)
+    : m_controlId(0)
+    , m_size(0)
+  {
+  }
+  //! copy operator: the charge is not copied
+  MemoryCharge &operator=(MemoryCharge const &)
+  {
+    return *this;
+  }
+  //! destructor: gives back the charged memory
+  ~MemoryCharge()
+  {
+    release();
+  }
+  /** charges a new allocation to the parsing of the current thread,
+      throws a MemoryException if the memory budget is exceeded */
+  void charge(char const *subsystem, unsigned long size)
+  {
+    unsigned long controlId=ParseControl::getCurrentId();
+    if (!controlId) return;
+    if (controlId!=m_controlId) {
+      release();
+      m_controlId=controlId;
+    }
+    ParseControl::chargeMemory(subsystem, size);
+    m_size+=size;
+  }
+  //! gives back the charged memory
+  void release()
+  {
+    if (m_size)
+      ParseControl::releaseMemory(m_controlId, m_size);
+    m_size=0;
+  }
+protected:
+  //! the identifier of the charged control
+  unsigned long m_controlId;
+  //! the charged size
+  unsigned long m_size;
+};
 }
 
 /* ---------- input ----------------- */
@@ -456,6 +661,27 @@ struct STOFFEmbeddedObject {
   librevenge::RVNGString m_filenameLink;
 };
 
+/** small class used to store the pictures' data of a document
+
+    \note the data are indexed by their content, so that the identical pictures decoded
+    by a document parser share the same binary buffer
+ */
+class STOFFPictureStore
+{
+public:
+  //! constructor
+  STOFFPictureStore() : m_hashToDataMap()
+  {
+  }
+  //! returns the stored data identical to data if it exists, if not stores data and returns it
+  librevenge::RVNGBinaryData const &get(librevenge::RVNGBinaryData const &data);
+protected:
+  //! returns a hash value of the data content
+  static unsigned long hash(librevenge::RVNGBinaryData const &data);
+  //! a multimap hash to data
+  std::multimap<unsigned long, librevenge::RVNGBinaryData> m_hashToDataMap;
+};
+
 // forward declarations of basic classes and smart pointers
 class STOFFFont;
 class STOFFFrameStyle;
@@ -1136,6 +1362,8 @@ namespace libstoff
 {
 //! convert a date/time in a date time format
 bool convertToDateTime(uint32_t date, uint32_t time, std::string &dateTime);
+//! convert a windows FILETIME (the number of 100 ns since 1601/01/01) in a date time format
+bool convertFileTimeToDateTime(unsigned long low, unsigned long high, std::string &dateTime);
 //! split a string in two. If the delimiter is not present, string1=string
 void splitString(librevenge::RVNGString const &string, librevenge::RVNGString const &delim,
                  librevenge::RVNGString &string1, librevenge::RVNGString &string2);